@@ -0,0 +1,285 @@
+extends Control
+
+## Behavior checks for the natively computed attributes and the value type arithmetic.
+## Run it headless to get the number of failed checks as the exit code:
+## godot --headless --path godot res://examples/derived_attributes_checks/derived_attributes_checks.tscn
+
+const FIXED_ONE := 65536
+
+@onready var results_v_box_container: VBoxContainer = %ResultsVBoxContainer
+@onready var summary_label: Label = %SummaryLabel
+
+var checks := 0
+var failures := 0
+
+
+func _ready() -> void:
+	print("The errors printed while checking the invalid expressions are expected.")
+
+	check_expressions()
+	check_invalid_expressions()
+	check_linear_batch()
+	check_curves()
+	check_bounds()
+	check_value_arithmetic()
+
+	summary_label.text = str(checks - failures) + "/" + str(checks) + " checks passed"
+	print(summary_label.text)
+
+	if DisplayServer.get_name() == "headless":
+		get_tree().quit(failures)
+
+
+func check(description: String, actual: float, expected: float, tolerance := 0.0001) -> void:
+	var passed := absf(actual - expected) <= tolerance
+	var label := Label.new()
+
+	checks += 1
+
+	if not passed:
+		failures += 1
+
+	label.text = ("PASS " if passed else "FAIL ") + description + ": got " + str(actual) + ", expected " + str(expected)
+	label.modulate = Color.WHITE if passed else Color.RED
+
+	results_v_box_container.add_child(label)
+	print(label.text)
+
+
+func check_true(description: String, condition: bool) -> void:
+	check(description, 1.0 if condition else 0.0, 1.0)
+
+
+func make_attribute(attribute_name: String, default_value := 0.0) -> Attribute:
+	var attribute := Attribute.new()
+	attribute.attribute_name = attribute_name
+	attribute.default_value = default_value
+	return attribute
+
+
+func make_expression(attribute_name: String, expression: String) -> ExpressionAttribute:
+	var attribute := ExpressionAttribute.new()
+	attribute.attribute_name = attribute_name
+	attribute.expression = expression
+	return attribute
+
+
+func make_linear(attribute_name: String, weights: Dictionary, bias: float) -> LinearAttribute:
+	var attribute := LinearAttribute.new()
+	attribute.attribute_name = attribute_name
+	attribute.weights = weights
+	attribute.bias = bias
+	return attribute
+
+
+func make_container(attributes: Array[AttributeBase]) -> AttributeContainer:
+	var attribute_set := AttributeSet.new()
+	var container := AttributeContainer.new()
+
+	for attribute in attributes:
+		attribute_set.add_attribute(attribute)
+
+	add_child(container)
+	container.set_attribute_set(attribute_set)
+
+	return container
+
+
+## Sets the value through a buff, as gameplay code does.
+func force_value(container: AttributeContainer, attribute_name: String, value: float) -> void:
+	var buff := AttributeBuff.new()
+	buff.attribute_name = attribute_name
+	buff.operation = AttributeOperation.forcefully_set_value(value)
+	container.apply_buff(buff)
+
+
+func check_expressions() -> void:
+	var cases := {
+		"1 + base * 4 - 6 / 2": 10.0, # precedence
+		"(1 + base) * 4": 16.0,
+		"2 ^ base ^ 2": 512.0, # right associative, 2 ^ 9
+		"-base ^ 2": -9.0, # the power binds tighter than the unary minus
+		"2 * -base": -6.0,
+		"10 % base": 1.0,
+		"10 / (base - 3)": 0.0, # division by zero yields zero
+		"10 % (base - 3)": 0.0,
+		"clamp(base * 10, 0, 25)": 25.0,
+		"min(base, 1) + max(base, 5)": 6.0,
+		"abs(-base) + floor(2.5) + ceil(2.5) + round(2.4)": 10.0,
+		"sqrt(base * 12) + pow(base, 2)": 15.0,
+		"sqrt(-base)": 0.0,
+	}
+	var attributes: Array[AttributeBase] = [make_attribute("base")]
+	var names: Array[String] = []
+
+	for expression in cases:
+		names.append("expression_" + str(names.size()))
+		attributes.append(make_expression(names.back(), expression))
+
+	attributes.append(make_expression("uses_value", "value * 2 + base"))
+
+	var container := make_container(attributes)
+
+	force_value(container, "base", 3.0)
+
+	var expressions := cases.keys()
+
+	for i in names.size():
+		check("expression '" + expressions[i] + "' with base 3", container.get_attribute_value_by_name(names[i]), cases[expressions[i]])
+
+	force_value(container, "uses_value", 7.0)
+	check("expression 'value * 2 + base' operates on the buffed value", container.get_attribute_value_by_name("uses_value"), 17.0)
+
+
+func check_invalid_expressions() -> void:
+	var unknown_identifier := make_expression("broken", "missing * 2 + base")
+
+	check_true("unknown identifiers are collected as variables", unknown_identifier.is_valid_expression() and unknown_identifier.get_variables() == PackedStringArray(["missing", "base"]))
+	check_true("an unknown function is rejected", not make_expression("unknown_function", "unknown(1)").is_valid_expression())
+	check_true("a dangling operator is rejected", not make_expression("dangling", "1 +").is_valid_expression())
+	check_true("a wrong arity is rejected", not make_expression("arity", "min(1)").is_valid_expression())
+	check_true("deeply nested unary operators are rejected", not make_expression("unary", "-".repeat(100000) + "1").is_valid_expression())
+	check_true("deeply nested parentheses are rejected", not make_expression("parentheses", "(".repeat(100000) + "1" + ")".repeat(100000)).is_valid_expression())
+	check_true("nesting within the limit is accepted", make_expression("nested", "(".repeat(32) + "-1" + ")".repeat(32)).is_valid_expression())
+
+
+func check_linear_batch() -> void:
+	var inputs := [[3.0, 4.0], [-1.0, 0.25]]
+	# d depends on c, so the batch has to evaluate it after c.
+	var attributes: Array[AttributeBase] = [
+		make_linear("d", { "c": 0.5 }, 0.0),
+		make_linear("c", { "a": 2.0, "b": 1.0 }, 1.0),
+		make_attribute("a"),
+		make_attribute("b"),
+	]
+	var attribute_set := AttributeSet.new()
+	var world := AttributeWorld.new()
+	var batch: Array[AttributeContainer] = []
+	var in_world: Array[AttributeContainer] = []
+
+	for attribute in attributes:
+		attribute_set.add_attribute(attribute)
+
+	for i in inputs.size():
+		batch.append(AttributeContainer.new())
+		in_world.append(AttributeContainer.new())
+		in_world[i].world = world
+
+		for container in [batch[i], in_world[i]]:
+			add_child(container)
+			container.set_attribute_set(attribute_set)
+			container.set_values_by_names(PackedStringArray(["a", "b"]), PackedFloat32Array(inputs[i]))
+
+	for i in inputs.size():
+		var a: float = inputs[i][0]
+		var b: float = inputs[i][1]
+		var expected_c := 2.0 * a + b + 1.0
+
+		check("native linear c with a " + str(a) + " and b " + str(b), batch[i].get_attribute_value_by_name("c"), expected_c)
+		check("native chained linear d", batch[i].get_attribute_value_by_name("d"), expected_c * 0.5)
+
+	# changing the weights or the bias recomputes nothing, only the batch calls below pick the new model up.
+	attribute_set.find_by_name("c").weights = { "a": 3.0, "b": 1.0 }
+	attribute_set.find_by_name("c").bias = 2.0
+	attribute_set.find_by_name("d").bias = 1.0
+
+	AttributeContainer.recompute_linear_attributes_batch(batch)
+
+	for i in inputs.size():
+		var a: float = inputs[i][0]
+		var b: float = inputs[i][1]
+		var expected_c := 3.0 * a + b + 2.0
+
+		check("batched linear c with the new weights", batch[i].get_attribute_value_by_name("c"), expected_c)
+		check("batched chained linear d with the new bias", batch[i].get_attribute_value_by_name("d"), expected_c * 0.5 + 1.0)
+		check("the batch leaves the world containers alone", in_world[i].get_attribute_value_by_name("c"), 2.0 * a + b + 1.0)
+
+	world.recompute_linear_attributes()
+
+	for i in inputs.size():
+		var expected_c: float = 3.0 * inputs[i][0] + inputs[i][1] + 2.0
+
+		check("world linear c with the new weights", in_world[i].get_attribute_value_by_name("c"), expected_c)
+		check("world chained linear d with the new bias", in_world[i].get_attribute_value_by_name("d"), expected_c * 0.5 + 1.0)
+
+
+func check_curves() -> void:
+	var sampled := CurveAttribute.new()
+	sampled.attribute_name = "sampled"
+	sampled.input_attribute = "level"
+	sampled.input_min = 0.0
+	sampled.input_max = 10.0
+	sampled.samples = PackedFloat32Array([0.0, 10.0, 40.0])
+
+	check("samples lut between the first two samples", sampled.sample(2.5), 5.0)
+	check("samples lut between the last two samples", sampled.sample(7.5), 25.0)
+	check("samples lut clamps below the range", sampled.sample(-5.0), 0.0)
+	check("samples lut clamps above the range", sampled.sample(20.0), 40.0)
+
+	var curve := Curve.new()
+	curve.add_point(Vector2(0.0, 0.0))
+	curve.add_point(Vector2(0.5, 0.8))
+	curve.add_point(Vector2(1.0, 1.0))
+
+	var baked := CurveAttribute.new()
+	baked.attribute_name = "baked"
+	baked.input_attribute = "level"
+	baked.resolution = 256
+	baked.curve = curve
+
+	for input in [0.0, 0.1, 0.33, 0.5, 0.9, 1.0]:
+		check("curve lut matches Curve.sample at " + str(input), baked.sample(input), curve.sample(input), 0.001)
+
+	var container := make_container([make_attribute("level"), sampled])
+
+	force_value(container, "level", 5.0)
+	check("curve attribute follows its input attribute", container.get_attribute_value_by_name("sampled"), 10.0)
+
+
+func check_bounds() -> void:
+	var health := make_attribute("health", 100.0)
+	health.max_attribute = "max_health"
+
+	var container := make_container([make_attribute("max_health", 100.0), health])
+
+	container.get_attribute_by_name("max_health").value = 50.0
+	check("setting the bound re-clamps the bounded value", container.get_attribute_value_by_name("health"), 50.0)
+
+	container.get_attribute_by_name("health").value = 80.0
+	check("setting the bounded value clamps it", container.get_attribute_value_by_name("health"), 50.0)
+
+
+## FixedValue keeps 16 fractional bits, products are floored, quotients truncated toward zero and both saturate out of range.
+func check_value_arithmetic() -> void:
+	var is_fixed := absf(AttributeOperation.forcefully_set_value(0.1).get_value() - 0.1) > 0.000001
+	var cases := [[2.5, 1.0 / 3.0], [-2.5, 1.0 / 3.0], [1.0, 3.0], [-1.0, 3.0], [10.0, 0.7]]
+	# fixed results are exact, a single raw unit is 1 / 65536. Floating point results only carry the operand rounding.
+	var tolerance := 0.000000001 if is_fixed else 0.00001
+
+	print("Value type: " + ("FixedValue" if is_fixed else "floating point"))
+
+	for operands in cases:
+		var base: float = operands[0]
+		var value: float = operands[1]
+		var expected_product := base * value
+		var expected_quotient := base / value
+
+		if is_fixed:
+			var raw_base := roundi(base * FIXED_ONE)
+			var raw_value := roundi(value * FIXED_ONE)
+
+			expected_product = float((raw_base * raw_value) >> 16) / FIXED_ONE
+			expected_quotient = float((raw_base * FIXED_ONE) / raw_value) / FIXED_ONE
+
+		check(str(base) + " * " + str(value), AttributeOperation.multiply(value).operate(base), expected_product, tolerance)
+		check(str(base) + " / " + str(value), AttributeOperation.divide(value).operate(base), expected_quotient, tolerance)
+
+	if is_fixed:
+		var fixed_max := 9223372036854775807 / float(FIXED_ONE)
+
+		check("products past the fixed range saturate", AttributeOperation.multiply(1e8).operate(1e7), fixed_max, 1.0)
+		check("negative products past the fixed range saturate", AttributeOperation.multiply(-1e8).operate(1e7), -fixed_max, 1.0)
+		check("quotients past the fixed range saturate", AttributeOperation.divide(0.001).operate(1e12), fixed_max, 1.0)
+
+	check("division by zero yields zero", AttributeOperation.divide(0.0).operate(5.0), 0.0)
+	check("percentage", AttributeOperation.percentage(50.0).operate(200.0), 300.0)
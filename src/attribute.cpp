@@ -10,6 +10,7 @@
 
 #include "attribute.hpp"
 #include "attribute_container.hpp"
+#include "attribute_world.hpp"
 
 using namespace octod::gameplay::attributes;
 
@@ -45,7 +46,7 @@ void AttributeOperation::_bind_methods()
 	BIND_ENUM_CONSTANT(OP_SET);
 }
 
-Ref<AttributeOperation> AttributeOperation::create(const OperationType p_operand, const float p_value)
+Ref<AttributeOperation> AttributeOperation::create(const OperationType p_operand, const attribute_real_t p_value)
 {
 	Ref operation = memnew(AttributeOperation);
 	operation->set_operand(p_operand);
@@ -53,32 +54,32 @@ Ref<AttributeOperation> AttributeOperation::create(const OperationType p_operand
 	return operation;
 }
 
-Ref<AttributeOperation> AttributeOperation::add(const float p_value)
+Ref<AttributeOperation> AttributeOperation::add(const attribute_real_t p_value)
 {
 	return create(OP_ADD, p_value);
 }
 
-Ref<AttributeOperation> AttributeOperation::divide(const float p_value)
+Ref<AttributeOperation> AttributeOperation::divide(const attribute_real_t p_value)
 {
 	return create(OP_DIVIDE, p_value);
 }
 
-Ref<AttributeOperation> AttributeOperation::multiply(const float p_value)
+Ref<AttributeOperation> AttributeOperation::multiply(const attribute_real_t p_value)
 {
 	return create(OP_MULTIPLY, p_value);
 }
 
-Ref<AttributeOperation> AttributeOperation::percentage(const float p_value)
+Ref<AttributeOperation> AttributeOperation::percentage(const attribute_real_t p_value)
 {
 	return create(OP_PERCENTAGE, p_value);
 }
 
-Ref<AttributeOperation> AttributeOperation::subtract(const float p_value)
+Ref<AttributeOperation> AttributeOperation::subtract(const attribute_real_t p_value)
 {
 	return create(OP_SUBTRACT, p_value);
 }
 
-Ref<AttributeOperation> AttributeOperation::forcefully_set_value(const float p_value)
+Ref<AttributeOperation> AttributeOperation::forcefully_set_value(const attribute_real_t p_value)
 {
 	return create(OP_SET, p_value);
 }
@@ -89,7 +90,7 @@ bool AttributeOperation::equals_to(const Ref<AttributeOperation> &other) const
 		return false;
 	}
 
-	return operand == other->operand && Math::is_equal_approx(value, other->value);
+	return operand == other->operand && is_equal_value(value, other->value);
 }
 
 int AttributeOperation::get_operand() const
@@ -97,29 +98,19 @@ int AttributeOperation::get_operand() const
 	return operand;
 }
 
-float AttributeOperation::get_value() const
+attribute_real_t AttributeOperation::get_value() const
 {
-	return value;
+	return to_real(value);
 }
 
-float AttributeOperation::operate(float p_base_value) const
+attribute_real_t AttributeOperation::operate(const attribute_real_t p_base_value) const
 {
-	switch (operand) {
-		case OP_ADD:
-			return p_base_value + value;
-		case OP_DIVIDE:
-			return Math::absf(value) < 0.0001f ? 0 : p_base_value / value;
-		case OP_MULTIPLY:
-			return p_base_value * value;
-		case OP_PERCENTAGE:
-			return p_base_value + ((p_base_value / 100) * value);
-		case OP_SUBTRACT:
-			return p_base_value - value;
-		case OP_SET:
-			return value;
-		default:
-			return p_base_value;
-	}
+	return to_real(operate_native(p_base_value));
+}
+
+attribute_value_t AttributeOperation::operate_native(const attribute_value_t p_base_value) const
+{
+	return operate_value(operand, p_base_value, value);
 }
 
 void AttributeOperation::set_operand(const int p_value)
@@ -127,7 +118,7 @@ void AttributeOperation::set_operand(const int p_value)
 	operand = static_cast<OperationType>(p_value);
 }
 
-void AttributeOperation::set_value(const float p_value)
+void AttributeOperation::set_value(const attribute_real_t p_value)
 {
 	value = p_value;
 }
@@ -141,6 +132,7 @@ void AttributeBuffBase::_bind_methods()
 	/// binds virtuals to godot
 	GDVIRTUAL_BIND(_applies_to, "attribute_set");
 	GDVIRTUAL_BIND(_operate, "values", "attribute_set");
+	GDVIRTUAL_BIND(_operate_packed, "values", "attribute_set");
 }
 
 #pragma endregion
@@ -159,6 +151,7 @@ void AttributeBuff::_bind_methods()
 	ClassDB::bind_method(D_METHOD("get_parent_buff"), &AttributeBuff::get_parent_buff);
 	ClassDB::bind_method(D_METHOD("get_queue_execution"), &AttributeBuff::get_queue_execution);
 	ClassDB::bind_method(D_METHOD("get_stack_size"), &AttributeBuff::get_stack_size);
+	ClassDB::bind_method(D_METHOD("get_static_targets"), &AttributeBuff::get_static_targets);
 	ClassDB::bind_method(D_METHOD("get_transient"), &AttributeBuff::get_transient);
 	ClassDB::bind_method(D_METHOD("get_unique"), &AttributeBuff::get_unique);
 	ClassDB::bind_method(D_METHOD("operate", "base_value"), &AttributeBuff::operate);
@@ -171,6 +164,7 @@ void AttributeBuff::_bind_methods()
 	ClassDB::bind_method(D_METHOD("set_parent_buff", "p_value"), &AttributeBuff::set_parent_buff);
 	ClassDB::bind_method(D_METHOD("set_queue_execution", "p_value"), &AttributeBuff::set_queue_execution);
 	ClassDB::bind_method(D_METHOD("set_stack_size", "p_value"), &AttributeBuff::set_stack_size);
+	ClassDB::bind_method(D_METHOD("set_static_targets", "p_value"), &AttributeBuff::set_static_targets);
 	ClassDB::bind_method(D_METHOD("set_transient", "p_value"), &AttributeBuff::set_transient);
 	ClassDB::bind_method(D_METHOD("set_unique", "p_value"), &AttributeBuff::set_unique);
 
@@ -184,6 +178,7 @@ void AttributeBuff::_bind_methods()
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "max_applies"), "set_stack_size", "get_stack_size");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "stack_size"), "set_stack_size", "get_stack_size");
 	ADD_PROPERTY(PropertyInfo(Variant::INT, "queue_execution", PROPERTY_HINT_ENUM, "Parallel:0,Waterfall:1"), "set_queue_execution", "get_queue_execution");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "static_targets"), "set_static_targets", "get_static_targets");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "transient"), "set_transient", "get_transient");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "unique"), "set_unique", "get_unique");
 
@@ -207,10 +202,15 @@ bool AttributeBuff::equals_to(const Ref<AttributeBuff> &buff) const
 			Math::is_equal_approx(buff->duration, duration) && attribute_name == buff->attribute_name && buff_name == buff->buff_name && duration_merging == buff->duration_merging && max_stacking == buff->max_stacking && queue_execution == buff->queue_execution && transient == buff->transient && unique == buff->unique);
 }
 
-float AttributeBuff::operate(const float base_value) const
+attribute_real_t AttributeBuff::operate(const attribute_real_t base_value) const
 {
-	ERR_FAIL_COND_V_MSG(operation.is_null(), 0.0f, "AttributeBuff operation is null, cannot operate on base value.");
-	return operation->operate(base_value);
+	return to_real(operate_native(base_value));
+}
+
+attribute_value_t AttributeBuff::operate_native(const attribute_value_t p_base_value) const
+{
+	ERR_FAIL_COND_V_MSG(operation.is_null(), p_base_value, "AttributeBuff operation is null, cannot operate on base value.");
+	return operation->operate_native(p_base_value);
 }
 
 String AttributeBuff::get_attribute_name() const
@@ -247,9 +247,89 @@ bool AttributeBuff::get_unique() const
 	return unique;
 }
 
+bool AttributeBuff::get_static_targets() const
+{
+	return static_targets;
+}
+
 bool AttributeBuff::is_operate_overridden() const
 {
-	return GDVIRTUAL_IS_OVERRIDDEN_PTR(this, _operate);
+	return GDVIRTUAL_IS_OVERRIDDEN_PTR(this, _operate) || GDVIRTUAL_IS_OVERRIDDEN_PTR(this, _operate_packed);
+}
+
+bool AttributeBuff::resolve_static_targets(const Ref<AttributeSet> &p_attribute_set, LocalVector<int> &r_handles) const
+{
+	r_handles.clear();
+
+	ERR_FAIL_COND_V_MSG(p_attribute_set.is_null(), false, "Attribute set cannot be null.");
+
+	const uint64_t attribute_set_id = p_attribute_set->get_instance_id();
+
+	static_targets_clock++;
+
+	for (StaticTargets &cached : static_targets_cache) {
+		if (cached.attribute_set_id == attribute_set_id && cached.revision == p_attribute_set->revision) {
+			cached.last_used = static_targets_clock;
+
+			for (const int handle : cached.handles) {
+				r_handles.push_back(handle);
+			}
+
+			return true;
+		}
+	}
+
+	TypedArray<AttributeBase> _attributes;
+
+	ERR_FAIL_COND_V_MSG(!GDVIRTUAL_IS_OVERRIDDEN_PTR(this, _applies_to), false, "Buff must override the _applies_to method to apply to derived attributes.");
+	ERR_FAIL_COND_V_MSG(!GDVIRTUAL_CALL_PTR(this, _applies_to, p_attribute_set, _attributes), false, "An error occurred calling the overridden _applies_to method.");
+
+	for (int64_t i = 0; i < _attributes.size(); i++) {
+		const AttributeBase *attribute_base = cast_to<AttributeBase>(_attributes[i]);
+		const int handle = attribute_base != nullptr ? p_attribute_set->resolve_handle(attribute_base->get_attribute_name()) : -1;
+
+		if (handle < 0) {
+			r_handles.clear();
+			ERR_FAIL_V_MSG(false, "Static targets must be attributes of the attribute set.");
+		}
+
+		r_handles.push_back(handle);
+	}
+
+	/// the cache is looked up again, `_applies_to` may have resolved this buff for other sets meanwhile.
+	StaticTargets *targets = nullptr;
+
+	for (StaticTargets &cached : static_targets_cache) {
+		if (cached.attribute_set_id == attribute_set_id) {
+			targets = &cached;
+			break;
+		}
+	}
+
+	if (targets == nullptr && static_targets_cache.size() < STATIC_TARGETS_CACHE_SIZE) {
+		static_targets_cache.push_back({});
+		targets = &static_targets_cache[static_targets_cache.size() - 1];
+	} else if (targets == nullptr) {
+		/// the cache is full, the least recently used entry is reused along with its handles capacity.
+		targets = &static_targets_cache[0];
+
+		for (StaticTargets &cached : static_targets_cache) {
+			if (cached.last_used < targets->last_used) {
+				targets = &cached;
+			}
+		}
+	}
+
+	targets->attribute_set_id = attribute_set_id;
+	targets->revision = p_attribute_set->revision;
+	targets->last_used = static_targets_clock;
+	targets->handles.clear();
+
+	for (const int handle : r_handles) {
+		targets->handles.push_back(handle);
+	}
+
+	return true;
 }
 
 Ref<AttributeOperation> AttributeBuff::get_operation() const
@@ -317,6 +397,12 @@ void AttributeBuff::set_queue_execution(int p_value)
 	queue_execution = static_cast<QueueExecution>(p_value);
 }
 
+void AttributeBuff::set_static_targets(const bool p_value)
+{
+	static_targets = p_value;
+	static_targets_cache.clear();
+}
+
 void AttributeBuff::set_transient(const bool p_value)
 {
 	transient = p_value;
@@ -341,7 +427,7 @@ AttributeBuff *AttributeComputationArgument::get_buff() const
 	return buff;
 }
 
-float AttributeComputationArgument::get_operated_value() const
+attribute_real_t AttributeComputationArgument::get_operated_value() const
 {
 	return operated_value;
 }
@@ -365,7 +451,7 @@ void AttributeComputationArgument::set_buff(AttributeBuff *p_buff)
 	buff = p_buff;
 }
 
-void AttributeComputationArgument::set_operated_value(const float &p_value)
+void AttributeComputationArgument::set_operated_value(const attribute_real_t &p_value)
 {
 	operated_value = p_value;
 }
@@ -406,6 +492,21 @@ void AttributeBase::_bind_methods()
 	/// binds methods to godot
 	ClassDB::bind_method(D_METHOD("get_attribute_name"), &AttributeBase::get_attribute_name);
 	ClassDB::bind_method(D_METHOD("set_attribute_name", "p_value"), &AttributeBase::set_attribute_name);
+	ClassDB::bind_method(D_METHOD("get_default_value"), &AttributeBase::get_default_value);
+	ClassDB::bind_method(D_METHOD("get_max_attribute"), &AttributeBase::get_max_attribute);
+	ClassDB::bind_method(D_METHOD("get_max_value"), &AttributeBase::get_max_value);
+	ClassDB::bind_method(D_METHOD("get_min_value"), &AttributeBase::get_min_value);
+	ClassDB::bind_method(D_METHOD("get_use_max_value"), &AttributeBase::get_use_max_value);
+	ClassDB::bind_method(D_METHOD("get_use_min_value"), &AttributeBase::get_use_min_value);
+	ClassDB::bind_method(D_METHOD("is_bounded"), &AttributeBase::is_bounded);
+	ClassDB::bind_method(D_METHOD("is_pure"), &AttributeBase::is_pure);
+	ClassDB::bind_method(D_METHOD("set_default_value", "p_value"), &AttributeBase::set_default_value);
+	ClassDB::bind_method(D_METHOD("set_max_attribute", "p_value"), &AttributeBase::set_max_attribute);
+	ClassDB::bind_method(D_METHOD("set_max_value", "p_value"), &AttributeBase::set_max_value);
+	ClassDB::bind_method(D_METHOD("set_min_value", "p_value"), &AttributeBase::set_min_value);
+	ClassDB::bind_method(D_METHOD("set_pure", "p_value"), &AttributeBase::set_pure);
+	ClassDB::bind_method(D_METHOD("set_use_max_value", "p_value"), &AttributeBase::set_use_max_value);
+	ClassDB::bind_method(D_METHOD("set_use_min_value", "p_value"), &AttributeBase::set_use_min_value);
 
 	/// binds virtuals to godot
 	GDVIRTUAL_BIND(_derived_from, "attribute_set");
@@ -413,6 +514,14 @@ void AttributeBase::_bind_methods()
 
 	/// binds properties to godot
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "attribute_name"), "set_attribute_name", "get_attribute_name");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "default_value"), "set_default_value", "get_default_value");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "pure"), "set_pure", "is_pure");
+	ADD_GROUP("Bounds", "");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_min_value"), "set_use_min_value", "get_use_min_value");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "min_value"), "set_min_value", "get_min_value");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_max_value"), "set_use_max_value", "get_use_max_value");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "max_value"), "set_max_value", "get_max_value");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "max_attribute"), "set_max_attribute", "get_max_attribute");
 }
 
 String AttributeBase::get_attribute_name() const
@@ -424,11 +533,106 @@ String AttributeBase::get_attribute_name() const
 	return attribute_name;
 }
 
+attribute_real_t AttributeBase::get_default_value() const
+{
+	return default_value;
+}
+
+String AttributeBase::get_max_attribute() const
+{
+	return max_attribute;
+}
+
+attribute_real_t AttributeBase::get_max_value() const
+{
+	return max_value;
+}
+
+attribute_real_t AttributeBase::get_min_value() const
+{
+	return min_value;
+}
+
+bool AttributeBase::get_use_max_value() const
+{
+	return use_max_value;
+}
+
+bool AttributeBase::get_use_min_value() const
+{
+	return use_min_value;
+}
+
+bool AttributeBase::is_bounded() const
+{
+	return use_min_value || use_max_value || !max_attribute.is_empty();
+}
+
+bool AttributeBase::has_dependencies() const
+{
+	return GDVIRTUAL_IS_OVERRIDDEN_PTR(this, _derived_from) || is_natively_computed() || !max_attribute.is_empty();
+}
+
+bool AttributeBase::is_pure() const
+{
+	return pure;
+}
+
+bool AttributeBase::is_natively_computed() const
+{
+	return false;
+}
+
+attribute_real_t AttributeBase::compute_native_value([[maybe_unused]] RuntimeAttribute *p_runtime_attribute, const attribute_real_t p_operated_value) const
+{
+	return p_operated_value;
+}
+
+TypedArray<AttributeBase> AttributeBase::get_native_derived_from([[maybe_unused]] const Ref<AttributeSet> &p_attribute_set) const
+{
+	return {};
+}
+
 void AttributeBase::set_attribute_name(const String &p_value)
 {
 	attribute_name = p_value;
 }
 
+void AttributeBase::set_pure(const bool p_value)
+{
+	pure = p_value;
+}
+
+void AttributeBase::set_default_value(const attribute_real_t p_value)
+{
+	default_value = p_value;
+}
+
+void AttributeBase::set_max_attribute(const String &p_value)
+{
+	max_attribute = p_value;
+}
+
+void AttributeBase::set_max_value(const attribute_real_t p_value)
+{
+	max_value = p_value;
+}
+
+void AttributeBase::set_min_value(const attribute_real_t p_value)
+{
+	min_value = p_value;
+}
+
+void AttributeBase::set_use_max_value(const bool p_value)
+{
+	use_max_value = p_value;
+}
+
+void AttributeBase::set_use_min_value(const bool p_value)
+{
+	use_min_value = p_value;
+}
+
 #pragma endregion
 
 #pragma region Attribute
@@ -448,18 +652,30 @@ void AttributeSet::_bind_methods()
 	ClassDB::bind_method(D_METHOD("add_attributes", "p_attributes"), &AttributeSet::add_attributes);
 	ClassDB::bind_method(D_METHOD("find_by_classname", "p_classname"), &AttributeSet::find_by_classname);
 	ClassDB::bind_method(D_METHOD("find_by_name", "p_name"), &AttributeSet::find_by_name);
+	ClassDB::bind_method(D_METHOD("freeze"), &AttributeSet::freeze);
 	ClassDB::bind_method(D_METHOD("get_attributes_names"), &AttributeSet::get_attributes_names);
 	ClassDB::bind_method(D_METHOD("get_attributes"), &AttributeSet::get_attributes);
 	ClassDB::bind_method(D_METHOD("get_set_name"), &AttributeSet::get_set_name);
+	ClassDB::bind_method(D_METHOD("get_storage_precision"), &AttributeSet::get_storage_precision);
 	ClassDB::bind_method(D_METHOD("has_attribute", "p_attribute"), &AttributeSet::has_attribute);
+	ClassDB::bind_method(D_METHOD("is_frozen"), &AttributeSet::is_frozen);
 	ClassDB::bind_method(D_METHOD("remove_attribute", "p_attribute"), &AttributeSet::remove_attribute);
+	ClassDB::bind_method(D_METHOD("resolve_handle", "p_name"), &AttributeSet::resolve_handle);
 	ClassDB::bind_method(D_METHOD("remove_attributes", "p_attributes"), &AttributeSet::remove_attributes);
 	ClassDB::bind_method(D_METHOD("set_attributes", "p_attributes"), &AttributeSet::set_attributes);
+	ClassDB::bind_method(D_METHOD("set_frozen", "p_value"), &AttributeSet::set_frozen);
 	ClassDB::bind_method(D_METHOD("set_set_name", "p_value"), &AttributeSet::set_set_name);
+	ClassDB::bind_method(D_METHOD("set_storage_precision", "p_value"), &AttributeSet::set_storage_precision);
 
 	/// binds properties to godot
 	ADD_PROPERTY(PropertyInfo(Variant::ARRAY, "attributes", PROPERTY_HINT_RESOURCE_TYPE, "24/17:AttributeBase"), "set_attributes", "get_attributes");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "frozen"), "set_frozen", "is_frozen");
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "set_name"), "set_set_name", "get_set_name");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "storage_precision", PROPERTY_HINT_ENUM, "Full:0,Half:1"), "set_storage_precision", "get_storage_precision");
+
+	/// binds enum constants
+	BIND_ENUM_CONSTANT(STORAGE_PRECISION_FULL);
+	BIND_ENUM_CONSTANT(STORAGE_PRECISION_HALF);
 
 	/// adds signals to godot
 	ADD_SIGNAL(MethodInfo("attribute_added", PropertyInfo(Variant::OBJECT, "attribute", PROPERTY_HINT_RESOURCE_TYPE, "AttributeBase")));
@@ -479,10 +695,14 @@ AttributeSet::AttributeSet(const TypedArray<AttributeBase> &p_attributes, const
 
 bool AttributeSet::add_attribute(const Ref<AttributeBase> &p_attribute)
 {
+	ERR_FAIL_COND_V_MSG(frozen, false, "Cannot add attributes to a frozen AttributeSet.");
+
 	if (!has_attribute(p_attribute)) {
 		const Ref<Attribute> d_attribute = p_attribute->duplicate(true);
 
 		attributes.push_back(d_attribute);
+		handles_dirty = true;
+		revision++;
 		emit_signal("attribute_added", d_attribute);
 		emit_changed();
 		return true;
@@ -493,6 +713,8 @@ bool AttributeSet::add_attribute(const Ref<AttributeBase> &p_attribute)
 
 uint16_t AttributeSet::add_attributes(const TypedArray<AttributeBase> &p_attributes)
 {
+	ERR_FAIL_COND_V_MSG(frozen, 0, "Cannot add attributes to a frozen AttributeSet.");
+
 	uint16_t count = 0;
 
 	for (int i = 0; i < p_attributes.size(); i++) {
@@ -502,6 +724,8 @@ uint16_t AttributeSet::add_attributes(const TypedArray<AttributeBase> &p_attribu
 			d_attribute = d_attribute->duplicate(true);
 
 			attributes.push_back(d_attribute);
+			handles_dirty = true;
+			revision++;
 			count++;
 			emit_signal("attribute_added", d_attribute);
 		}
@@ -519,6 +743,11 @@ int AttributeSet::find(const Ref<AttributeBase> &p_attribute) const
 	return static_cast<int>(attributes.find(p_attribute));
 }
 
+void AttributeSet::freeze()
+{
+	set_frozen(true);
+}
+
 Ref<AttributeBase> AttributeSet::find_by_classname(const String &p_classname) const
 {
 	for (int i = 0; i < attributes.size(); i++) {
@@ -572,6 +801,32 @@ String AttributeSet::get_set_name() const
 	return set_name;
 }
 
+int AttributeSet::get_storage_precision() const
+{
+	return storage_precision;
+}
+
+int AttributeSet::resolve_handle(const StringName &p_name) const
+{
+	if (handles_dirty) {
+		handles.clear();
+
+		for (int i = 0; i < attributes.size(); i++) {
+			if (const Ref<AttributeBase> attribute = attributes[i]; attribute.is_valid()) {
+				handles[attribute->get_attribute_name()] = i;
+			}
+		}
+
+		handles_dirty = false;
+	}
+
+	if (const int *handle = handles.getptr(p_name)) {
+		return *handle;
+	}
+
+	return -1;
+}
+
 bool AttributeSet::has_attribute(const Ref<AttributeBase> &p_attribute) const
 {
 	for (int i = 0; i < attributes.size(); i++) {
@@ -583,10 +838,19 @@ bool AttributeSet::has_attribute(const Ref<AttributeBase> &p_attribute) const
 	return false;
 }
 
+bool AttributeSet::is_frozen() const
+{
+	return frozen;
+}
+
 bool AttributeSet::remove_attribute(const Ref<AttributeBase> &p_attribute)
 {
+	ERR_FAIL_COND_V_MSG(frozen, false, "Cannot remove attributes from a frozen AttributeSet.");
+
 	if (const int64_t index = attributes.find(p_attribute); index != -1) {
 		attributes.remove_at(index);
+		handles_dirty = true;
+		revision++;
 		emit_signal("attribute_removed", p_attribute);
 		emit_changed();
 		return true;
@@ -597,11 +861,15 @@ bool AttributeSet::remove_attribute(const Ref<AttributeBase> &p_attribute)
 
 int AttributeSet::remove_attributes(const TypedArray<AttributeBase> &p_attributes)
 {
+	ERR_FAIL_COND_V_MSG(frozen, 0, "Cannot remove attributes from a frozen AttributeSet.");
+
 	int count = 0;
 
 	for (int i = 0; i < p_attributes.size(); i++) {
 		if (const int64_t index = attributes.find(p_attributes[i]); index != -1) {
 			attributes.remove_at(index);
+			handles_dirty = true;
+			revision++;
 			count++;
 			emit_signal("attribute_removed", p_attributes[i]);
 		}
@@ -616,14 +884,41 @@ int AttributeSet::remove_attributes(const TypedArray<AttributeBase> &p_attribute
 
 void AttributeSet::push_back(const Ref<AttributeBase> &p_attribute)
 {
+	ERR_FAIL_COND_MSG(frozen, "Cannot add attributes to a frozen AttributeSet.");
+
 	attributes.push_back(p_attribute);
+	handles_dirty = true;
+	revision++;
 	emit_signal("attribute_added", p_attribute);
 	emit_changed();
 }
 
 void AttributeSet::set_attributes(const TypedArray<AttributeBase> &p_attributes)
 {
+	ERR_FAIL_COND_MSG(frozen, "Cannot change the attributes of a frozen AttributeSet.");
+
 	attributes = p_attributes;
+	handles_dirty = true;
+	revision++;
+	emit_changed();
+}
+
+void AttributeSet::set_frozen(const bool p_value)
+{
+	if (frozen == p_value) {
+		return;
+	}
+
+	frozen = p_value;
+	derived_from_cache.clear();
+
+	/// the attributes array is shared with the scripts reading it, so it is locked too.
+	if (frozen) {
+		attributes.make_read_only();
+	} else {
+		attributes = attributes.duplicate();
+	}
+
 	emit_changed();
 }
 
@@ -633,6 +928,15 @@ void AttributeSet::set_set_name(const String &p_value)
 	emit_changed();
 }
 
+void AttributeSet::set_storage_precision(const int p_value)
+{
+	ERR_FAIL_COND_MSG(frozen, "Cannot change the storage precision of a frozen AttributeSet.");
+	ERR_FAIL_COND_MSG(p_value < STORAGE_PRECISION_FULL || p_value > STORAGE_PRECISION_HALF, "Invalid storage precision.");
+
+	storage_precision = static_cast<StoragePrecision>(p_value);
+	emit_changed();
+}
+
 int AttributeSet::count() const
 {
 	return static_cast<int>(attributes.size());
@@ -648,6 +952,8 @@ void RuntimeBuff::_bind_methods()
 	ClassDB::bind_method(D_METHOD("get_attribute_name"), &RuntimeBuff::get_attribute_name);
 	ClassDB::bind_method(D_METHOD("get_buff_name"), &RuntimeBuff::get_buff_name);
 	ClassDB::bind_method(D_METHOD("get_duration"), &RuntimeBuff::get_duration);
+	ClassDB::bind_method(D_METHOD("get_id"), &RuntimeBuff::get_id);
+	ClassDB::bind_method(D_METHOD("get_operation"), &RuntimeBuff::get_operation);
 	ClassDB::bind_method(D_METHOD("get_time_left"), &RuntimeBuff::get_time_left);
 	ClassDB::bind_method(D_METHOD("set_time_left", "p_value"), &RuntimeBuff::set_time_left);
 	ClassDB::bind_method(D_METHOD("get_buff"), &RuntimeBuff::get_buff);
@@ -662,9 +968,9 @@ bool RuntimeBuff::equals_to(const Ref<AttributeBuff> &p_buff) const
 	return buff->equals_to(p_buff);
 }
 
-Ref<RuntimeAttribute> RuntimeBuff::applies_to(const AttributeContainer *p_attribute_container) const
+Ref<RuntimeAttribute> RuntimeBuff::applies_to(AttributeContainer *p_attribute_container) const
 {
-	Ref<RuntimeAttribute> attribute = p_attribute_container->get_runtime_attribute_by_name(buff->get_attribute_name());
+	Ref<RuntimeAttribute> attribute = p_attribute_container->get_runtime_attribute_by_name(get_attribute_name());
 
 	ERR_FAIL_COND_V_MSG(attribute.is_null(), attribute, "Attribute not found in attribute set.");
 	ERR_FAIL_COND_V_MSG(!attribute.is_valid(), attribute, "Attribute reference is not valid.");
@@ -672,31 +978,40 @@ Ref<RuntimeAttribute> RuntimeBuff::applies_to(const AttributeContainer *p_attrib
 	return attribute;
 }
 
-float RuntimeBuff::operate(const Ref<RuntimeAttribute> &p_runtime_attribute) const
+attribute_real_t RuntimeBuff::operate(const Ref<RuntimeAttribute> &p_runtime_attribute) const
 {
 	ERR_FAIL_COND_V_MSG(!buff.is_valid(), 0.0f, "Buff is not valid, cannot operate on runtime attributes.");
 	ERR_FAIL_NULL_V_MSG(p_runtime_attribute, 0.0f, "Runtime attribute is null, cannot operate on it.");
 
-	return buff->operate(p_runtime_attribute->value);
+	if (owner != nullptr) {
+		if (const RuntimeAttribute::BuffRecord *record = owner->find_buff_record(record_id); record != nullptr) {
+			return to_real(record->operate(p_runtime_attribute->load_value()));
+		}
+	}
+
+	return to_real(buff->operate_native(p_runtime_attribute->load_value()));
 }
 
 bool RuntimeBuff::can_apply_to_attribute(const Ref<RuntimeAttribute> &p_attribute) const
 {
-	const Ref<RuntimeAttribute> applied_to = applies_to(p_attribute->attribute_container);
+	ERR_FAIL_COND_V_MSG(p_attribute.is_null(), false, "Attribute reference is not valid.");
 
-	ERR_FAIL_NULL_V_MSG(applied_to, false, "Attribute not found in attribute set.");
-	ERR_FAIL_COND_V_MSG(!applied_to.is_valid(), false, "Attribute reference is not valid.");
-
-	return applied_to->attribute->get_attribute_name() == p_attribute->attribute->get_attribute_name();
+	/// the attribute is owned by the container, comparing names spares a lookup.
+	return buff->get_attribute_name() == p_attribute->attribute->get_attribute_name();
 }
 
 bool RuntimeBuff::can_dequeue() const
 {
-	return Math::is_zero_approx(time_left);
+	return Math::is_zero_approx(get_time_left());
 }
 
 String RuntimeBuff::get_attribute_name() const
 {
+	/// multi-attribute buffs are stored as is, the owner knows the actual target.
+	if (owner != nullptr) {
+		return owner->get_attribute_name();
+	}
+
 	return buff->attribute_name;
 }
 
@@ -715,8 +1030,34 @@ float RuntimeBuff::get_duration() const
 	return buff->duration;
 }
 
+Ref<AttributeOperation> RuntimeBuff::get_operation() const
+{
+	if (owner != nullptr) {
+		if (const RuntimeAttribute::BuffRecord *record = owner->find_buff_record(record_id); record != nullptr && record->overridden) {
+			Ref<AttributeOperation> operation;
+			operation.instantiate();
+			operation->set_operand(record->operation.operand);
+			operation->set_value(to_real(record->operation.value));
+			return operation;
+		}
+	}
+
+	return buff->get_operation();
+}
+
+int RuntimeBuff::get_id() const
+{
+	return static_cast<int>(record_id);
+}
+
 float RuntimeBuff::get_time_left() const
 {
+	if (owner != nullptr) {
+		if (const RuntimeAttribute::BuffRecord *record = owner->find_buff_record(record_id)) {
+			return record->time_left;
+		}
+	}
+
 	return time_left;
 }
 
@@ -727,7 +1068,7 @@ bool RuntimeBuff::has_duration() const
 
 bool RuntimeBuff::is_operate_overridden() const
 {
-	return GDVIRTUAL_IS_OVERRIDDEN_PTR(buff, _operate);
+	return GDVIRTUAL_IS_OVERRIDDEN_PTR(buff, _operate) || GDVIRTUAL_IS_OVERRIDDEN_PTR(buff, _operate_packed);
 }
 
 bool RuntimeBuff::is_transient() const
@@ -744,12 +1085,41 @@ bool RuntimeBuff::is_transient_time_based() const
 
 void RuntimeBuff::set_buff(const Ref<AttributeBuff> &p_value)
 {
+	if (owner != nullptr && p_value.is_valid()) {
+		if (RuntimeAttribute::BuffRecord *record = owner->find_buff_record(record_id)) {
+			record->buff = p_value;
+			owner->refresh_buff_aggregates();
+			owner->mark_changed();
+		}
+	}
+
 	buff = p_value;
 }
 
 void RuntimeBuff::set_time_left(const float p_value)
 {
-	time_left = Math::clamp(p_value, 0.0f, buff->get_duration());
+	time_left_cell() = Math::clamp(p_value, 0.0f, buff->get_duration());
+
+	if (owner != nullptr) {
+		owner->mark_changed();
+	}
+}
+
+void RuntimeBuff::detach()
+{
+	time_left = get_time_left();
+	owner = nullptr;
+}
+
+float &RuntimeBuff::time_left_cell()
+{
+	if (owner != nullptr) {
+		if (RuntimeAttribute::BuffRecord *record = owner->find_buff_record(record_id)) {
+			return record->time_left;
+		}
+	}
+
+	return time_left;
 }
 
 #pragma endregion
@@ -766,10 +1136,13 @@ void RuntimeAttribute::_bind_methods()
 	ClassDB::bind_method(D_METHOD("get_attribute_name"), &RuntimeAttribute::get_attribute_name);
 	ClassDB::bind_method(D_METHOD("get_attribute_set"), &RuntimeAttribute::get_attribute_set);
 	ClassDB::bind_method(D_METHOD("get_buffed_value"), &RuntimeAttribute::get_buffed_value);
+	ClassDB::bind_method(D_METHOD("get_buff_by_id", "p_id"), &RuntimeAttribute::get_buff_by_id);
 	ClassDB::bind_method(D_METHOD("get_buffs"), &RuntimeAttribute::get_buffs);
 	ClassDB::bind_method(D_METHOD("get_derived_from"), &RuntimeAttribute::get_derived_from);
+	ClassDB::bind_method(D_METHOD("get_handle"), &RuntimeAttribute::get_handle);
 	ClassDB::bind_method(D_METHOD("get_parent_runtime_attributes"), &RuntimeAttribute::get_parent_runtime_attributes);
 	ClassDB::bind_method(D_METHOD("get_value"), &RuntimeAttribute::get_value);
+	ClassDB::bind_method(D_METHOD("get_version"), &RuntimeAttribute::get_version);
 	ClassDB::bind_method(D_METHOD("has_ongoing_buffs"), &RuntimeAttribute::has_ongoing_buffs);
 	ClassDB::bind_method(D_METHOD("remove_buff", "p_buff"), &RuntimeAttribute::remove_buff);
 	ClassDB::bind_method(D_METHOD("set_attribute", "p_value"), &RuntimeAttribute::set_attribute);
@@ -789,71 +1162,127 @@ void RuntimeAttribute::_bind_methods()
 	ADD_SIGNAL(MethodInfo("attribute_touched", PropertyInfo(Variant::OBJECT, "attribute", PROPERTY_HINT_RESOURCE_TYPE, "RuntimeAttributeBase"), PropertyInfo(Variant::FLOAT, "buffed_value")));
 }
 
+RuntimeAttribute::~RuntimeAttribute()
+{
+	for (BuffRecord &record : buffs) {
+		if (record.wrapper.is_valid()) {
+			record.wrapper->detach();
+		}
+	}
+}
+
 Ref<RuntimeBuff> RuntimeAttribute::add_buff(const Ref<AttributeBuff> &p_buff)
 {
 	Ref<RuntimeBuff> runtime_buff;
 
-	if (!can_receive_buff(p_buff)) {
-		return runtime_buff;
+	if (int index; push_buff(p_buff, index)) {
+		if (index >= 0) {
+			runtime_buff = get_buff_wrapper(index);
+		} else {
+			/// non transient buffs are not stored, the wrapper is detached from the start.
+			runtime_buff = acquire_runtime_buff();
+			runtime_buff->buff = p_buff;
+			runtime_buff->time_left = p_buff->get_duration();
+		}
+	}
+
+	return runtime_buff;
+}
+
+bool RuntimeAttribute::push_buff(const Ref<AttributeBuff> &p_buff, int &r_index, const OperationOverride *p_override)
+{
+	r_index = -1;
+
+	if (p_override != nullptr ? !can_stack_buff(p_buff) : !can_receive_buff(p_buff)) {
+		return false;
 	}
 
-	runtime_buff.instantiate();
-	runtime_buff->buff = p_buff;
-	runtime_buff->time_left = p_buff->get_duration();
+	if (p_buff->get_transient()) {
+		if (const auto duration_merging = p_buff->get_duration_merging(); duration_merging == AttributeBuff::DURATION_MERGE_ADD || duration_merging == AttributeBuff::DURATION_MERGE_RESTART) {
+			for (uint32_t i = 0; i < buffs.size(); i++) {
+				if (BuffRecord &record = buffs[i]; record.buff->equals_to(p_buff)) {
+					const float time_left = duration_merging == AttributeBuff::DURATION_MERGE_ADD ? record.time_left + p_buff->get_duration() : p_buff->get_duration();
 
-	ERR_FAIL_COND_V_MSG(runtime_buff.is_null(), runtime_buff, "Failed to create runtime buff from attribute buff.");
+					record.time_left = Math::clamp(time_left, 0.0f, record.buff->get_duration());
 
-	if (p_buff->get_transient()) {		
-		if (const auto duration_merging = runtime_buff->buff->get_duration_merging(); duration_merging == AttributeBuff::DURATION_MERGE_ADD || duration_merging == AttributeBuff::DURATION_MERGE_RESTART) {
-			for (int i = 0; i < buffs.size(); i++) {
-				if (const auto maybe_runtime_buff = cast_to<RuntimeBuff>(buffs[i]); maybe_runtime_buff && maybe_runtime_buff->buff->equals_to(p_buff)) {
-					if (duration_merging == AttributeBuff::DURATION_MERGE_ADD) {
-						maybe_runtime_buff->set_time_left(maybe_runtime_buff->get_time_left() + p_buff->get_duration());
-					} else {
-						maybe_runtime_buff->set_time_left(p_buff->get_duration());
+					const uint32_t id = record.id;
+
+					mark_changed();
+					emit_buff_signal("buff_time_updated", i);
+
+					/// the listeners may add or remove buffs, the record is looked up again by id.
+					if (attribute_container != nullptr) {
+						attribute_container->_on_buff_time_updated(this, id);
 					}
 
-					emit_signal("buff_time_updated", maybe_runtime_buff);
-					return maybe_runtime_buff;
+					r_index = find_buff_index(id);
+
+					return true;
 				}
 			}
+		}
+
+		BuffRecord record;
+		record.buff = p_buff;
+		record.time_left = p_buff->get_duration();
+		record.id = next_buff_id++;
 
-			runtime_buff->set_time_left(p_buff->get_duration());
+		if (p_override != nullptr) {
+			record.overridden = true;
+			record.operation = *p_override;
 		}
 
-		buffs.push_back(runtime_buff);
-		emit_signal("buff_added", runtime_buff);
+		buffs.push_back(record);
+		refresh_buff_aggregates();
 
-		if (!Math::is_zero_approx(p_buff->get_duration())) {
-			emit_signal("buff_enqueued", runtime_buff);
-			emit_signal("attribute_touched", this, get_buffed_value());
+		mark_changed();
+		emit_buff_signal("buff_added", buffs.size() - 1);
+
+		/// the listeners may add or remove buffs, the record is looked up again by id after each emission.
+		if (attribute_container != nullptr) {
+			attribute_container->_on_buff_applied(this, record.id);
 		}
-	} else {
-		previous_value = value;
 
-		if (GDVIRTUAL_IS_OVERRIDDEN_PTR(attribute, _compute_value)) {
-			AttributeComputationArgument *argument = memnew(AttributeComputationArgument);
+		if (!Math::is_zero_approx(p_buff->get_duration())) {
+			if (const int index = find_buff_index(record.id); index >= 0) {
+				emit_buff_signal("buff_enqueued", index);
+			}
+
+			emit_touched();
+		}
 
-			argument->set_attribute_container(attribute_container);
-			argument->set_buff(p_buff.ptr());
-			argument->set_operated_value(runtime_buff->operate(this));
-			argument->set_runtime_attribute(this);
+		r_index = find_buff_index(record.id);
+	} else {
+		const attribute_value_t current_value = load_value();
+		const attribute_value_t operated_value = p_override != nullptr ? operate_value(p_override->operand, current_value, p_override->value) : p_buff->operate_native(current_value);
+		attribute_value_t new_value = operated_value;
+
+		if (attribute->is_natively_computed()) {
+			new_value = attribute->compute_native_value(this, to_real(operated_value));
+		} else if (GDVIRTUAL_IS_OVERRIDDEN_PTR(attribute, _compute_value)) {
+			new_value = call_compute_value(p_buff.ptr(), to_real(operated_value));
+		}
 
-			GDVIRTUAL_CALL_PTR(attribute, _compute_value, argument, value);
-		} else if (runtime_buff->can_apply_to_attribute(this)) {
-			value = runtime_buff->operate(this);
+		if (attribute->is_bounded()) {
+			new_value = clamp_value(new_value);
 		}
 
-		if (!Math::is_equal_approx(previous_value, value)) {
-			emit_signal("attribute_changed", this, previous_value, value);
-			emit_signal("attribute_touched", this, value);
+		store_values(current_value, new_value);
+
+		if (!is_equal_value(current_value, new_value)) {
+			notify_value_changed(current_value, new_value);
 		}
 	}
 
-	return runtime_buff;
+	return true;
 }
 
 bool RuntimeAttribute::can_receive_buff(const Ref<AttributeBuff> &p_buff) const
+{
+	return can_stack_buff(p_buff) && p_buff->get_attribute_name() == attribute->get_attribute_name();
+}
+
+bool RuntimeAttribute::can_stack_buff(const Ref<AttributeBuff> &p_buff) const
 {
 	if (p_buff->get_unique() && has_buff(p_buff)) {
 		return false;
@@ -861,44 +1290,361 @@ bool RuntimeAttribute::can_receive_buff(const Ref<AttributeBuff> &p_buff) const
 
 	int buffs_count = 0;
 
-	for (int i = 0; i < buffs.size(); i++) {
-		if (const Ref<RuntimeBuff> buff = buffs[i]; buff->equals_to(p_buff)) {
+	for (const BuffRecord &record : buffs) {
+		if (record.buff->equals_to(p_buff)) {
 			buffs_count++;
 		}
 	}
 
-	if (buffs_count >= p_buff->get_stack_size() && p_buff->get_stack_size() > 0) {
-		return false;
+	return buffs_count < p_buff->get_stack_size() || p_buff->get_stack_size() <= 0;
+}
+
+void RuntimeAttribute::compute_value()
+{
+	if (attribute->is_natively_computed()) {
+		commit_value(attribute->compute_native_value(this, get_value()));
+	} else if (GDVIRTUAL_IS_OVERRIDDEN_PTR(attribute, _compute_value)) {
+		commit_value(call_compute_value(nullptr, get_value()));
+	} else if (attribute->is_bounded()) {
+		/// the bounding attribute changed, re-clamps the current value.
+		commit_value(get_value());
 	}
+}
+
+attribute_real_t RuntimeAttribute::call_compute_value(AttributeBuff *p_buff, const attribute_real_t p_operated_value)
+{
+	attribute_real_t computed_value = p_operated_value;
+	attribute_real_t *key = nullptr;
+	uint32_t stride = 0;
+
+	if (attribute->is_pure() && attribute_container != nullptr) {
+		resolve_parents();
+
+		stride = parents.size() + 1;
+
+		/// the last row is the key of the current computation.
+		if (memo_inputs.size() != (MEMO_SIZE + 1) * stride) {
+			memo_inputs.resize((MEMO_SIZE + 1) * stride);
+			memo_count = 0;
+			memo_cursor = 0;
+		}
 
-	return p_buff->get_attribute_name() == attribute->get_attribute_name();
+		key = memo_inputs.ptr() + MEMO_SIZE * stride;
+		key[0] = p_operated_value;
+
+		for (uint32_t i = 0; i < parents.size(); i++) {
+			key[i + 1] = parents[i] ? parents[i]->get_buffed_value() : 0.0f;
+		}
+
+		for (uint32_t row = 0; row < memo_count; row++) {
+			const attribute_real_t *memoized = memo_inputs.ptr() + row * stride;
+			bool hit = true;
+
+			for (uint32_t i = 0; i < stride && hit; i++) {
+				hit = memoized[i] == key[i];
+			}
+
+			if (hit) {
+				return memo_results[row];
+			}
+		}
+	}
+
+	Ref<AttributeComputationArgument> argument;
+
+	if (attribute_container != nullptr) {
+		argument = attribute_container->argument_pool.acquire();
+	} else {
+		argument.instantiate();
+	}
+
+	argument->set_attribute_container(attribute_container);
+	argument->set_buff(p_buff);
+	argument->set_operated_value(p_operated_value);
+	argument->set_runtime_attribute(this);
+
+	GDVIRTUAL_CALL_PTR(attribute, _compute_value, argument, computed_value);
+
+	if (key != nullptr) {
+		attribute_real_t *row = memo_inputs.ptr() + memo_cursor * stride;
+
+		for (uint32_t i = 0; i < stride; i++) {
+			row[i] = key[i];
+		}
+
+		memo_results[memo_cursor] = computed_value;
+		memo_count = MAX(memo_count, memo_cursor + 1);
+		memo_cursor = (memo_cursor + 1) % MEMO_SIZE;
+	}
+
+	return computed_value;
 }
 
-void RuntimeAttribute::compute_value()
+attribute_value_t RuntimeAttribute::clamp_value(const attribute_value_t p_value)
 {
-	if (GDVIRTUAL_IS_OVERRIDDEN_PTR(attribute, _compute_value)) {
-		AttributeComputationArgument *argument = memnew(AttributeComputationArgument);
+	attribute_value_t clamped_value = p_value;
 
-		const float _previous_value = value;
+	/// the bound is resolved along with the parents, so the damage path does no name lookup.
+	if (attribute_container != nullptr) {
+		resolve_parents();
 
-		argument->set_attribute_container(attribute_container);
-		argument->set_buff(nullptr);
-		argument->set_operated_value(value);
-		argument->set_runtime_attribute(this);
+		if (max_bound != nullptr) {
+			clamped_value = MIN(clamped_value, max_bound->load_buffed_value());
+		}
+	}
+
+	if (attribute->get_use_max_value()) {
+		clamped_value = MIN(clamped_value, attribute_value_t(attribute->get_max_value()));
+	}
 
-		GDVIRTUAL_CALL_PTR(attribute, _compute_value, argument, value);
+	if (attribute->get_use_min_value()) {
+		clamped_value = MAX(clamped_value, attribute_value_t(attribute->get_min_value()));
+	}
+
+	return clamped_value;
+}
 
-		if (!Math::is_equal_approx(_previous_value, value)) {
-			previous_value = _previous_value;
-			emit_signal("attribute_changed", this, previous_value, value);
-			emit_signal("attribute_touched", this, value);
+void RuntimeAttribute::commit_value(attribute_value_t p_value)
+{
+	if (attribute->is_bounded()) {
+		p_value = clamp_value(p_value);
+	}
+
+	if (const attribute_value_t current_value = load_value(); !is_equal_value(current_value, p_value)) {
+		store_values(current_value, p_value);
+		notify_value_changed(current_value, p_value);
+	}
+}
+
+void RuntimeAttribute::bind_world(AttributeWorld *p_world, const uint32_t p_slot)
+{
+	ERR_FAIL_NULL_MSG(p_world, "World cannot be null.");
+	ERR_FAIL_COND_MSG(handle < 0, "Runtime attribute has no handle, cannot bind it to a world.");
+
+	p_world->ensure_column(handle);
+
+	AttributeWorld::Column &column = p_world->columns[handle];
+
+	column.values.set(p_slot, value);
+	column.previous_values.set(p_slot, previous_value);
+	world = p_world;
+	world_slot = p_slot;
+
+	refresh_buff_aggregates();
+}
+
+void RuntimeAttribute::unbind_world()
+{
+	if (world == nullptr) {
+		return;
+	}
+
+	value = load_value();
+	previous_value = load_previous_value();
+	world = nullptr;
+}
+
+void RuntimeAttribute::compute_buff_aggregates(attribute_value_t &r_additive, attribute_value_t &r_multiplier) const
+{
+	r_additive = 0.0f;
+	r_multiplier = 1.0f;
+
+	for (const BuffRecord &record : buffs) {
+		if (record.buff.is_valid()) {
+			switch (record.get_operand()) {
+				case OP_ADD:
+				case OP_SUBTRACT:
+					r_additive = record.operate(r_additive);
+					break;
+				case OP_MULTIPLY:
+				case OP_DIVIDE:
+				case OP_PERCENTAGE:
+					r_multiplier = record.operate(r_multiplier);
+					break;
+				default:
+					break;
+			}
+		}
+	}
+}
+
+void RuntimeAttribute::emit_buff_signal(const StringName &p_signal, const uint32_t p_index)
+{
+	if (has_connections(p_signal)) {
+		emit_signal(p_signal, get_buff_wrapper(p_index));
+	}
+}
+
+void RuntimeAttribute::notify_value_changed(const attribute_value_t p_previous_value, const attribute_value_t p_new_value)
+{
+	mark_changed();
+
+	/// the owner is called directly, before the listeners, as it was the first connection when the container used signals.
+	if (attribute_container != nullptr) {
+		attribute_container->_on_attribute_changed(this, p_previous_value, p_new_value);
+	}
+
+	if (has_connections("attribute_changed")) {
+		emit_signal("attribute_changed", this, to_real(p_previous_value), to_real(p_new_value));
+	}
+
+	if (has_connections("attribute_touched")) {
+		emit_signal("attribute_touched", this, to_real(p_new_value));
+	}
+}
+
+void RuntimeAttribute::emit_touched()
+{
+	/// the buffed value is recomputed only for the listeners.
+	if (has_connections("attribute_touched")) {
+		emit_signal("attribute_touched", this, get_buffed_value());
+	}
+}
+
+void RuntimeAttribute::mark_changed()
+{
+	version++;
+
+	if (attribute_container != nullptr) {
+		attribute_container->record_change(this);
+	}
+}
+
+Ref<RuntimeBuff> RuntimeAttribute::acquire_runtime_buff() const
+{
+	Ref<RuntimeBuff> runtime_buff;
+
+	if (attribute_container != nullptr) {
+		runtime_buff = attribute_container->buff_pool.acquire();
+	} else {
+		runtime_buff.instantiate();
+	}
+
+	/// recycled wrappers keep the state of their previous use.
+	runtime_buff->buff.unref();
+	runtime_buff->time_left = 0.0f;
+	runtime_buff->unique = false;
+	runtime_buff->owner = nullptr;
+	runtime_buff->record_id = 0;
+
+	return runtime_buff;
+}
+
+RuntimeAttribute::BuffRecord *RuntimeAttribute::find_buff_record(const uint32_t p_id)
+{
+	for (BuffRecord &record : buffs) {
+		if (record.id == p_id) {
+			return &record;
+		}
+	}
+
+	return nullptr;
+}
+
+int RuntimeAttribute::find_buff_index(const uint32_t p_id) const
+{
+	for (uint32_t i = 0; i < buffs.size(); i++) {
+		if (buffs[i].id == p_id) {
+			return static_cast<int>(i);
 		}
 	}
+
+	return -1;
+}
+
+Ref<RuntimeBuff> RuntimeAttribute::get_buff_wrapper(const uint32_t p_index)
+{
+	ERR_FAIL_INDEX_V_MSG(p_index, buffs.size(), {}, "Buff index out of bounds.");
+
+	BuffRecord &record = buffs[p_index];
+
+	if (record.wrapper.is_null()) {
+		record.wrapper = acquire_runtime_buff();
+		record.wrapper->buff = record.buff;
+		record.wrapper->owner = this;
+		record.wrapper->record_id = record.id;
+	}
+
+	return record.wrapper;
+}
+
+void RuntimeAttribute::remove_buff_at(const uint32_t p_index)
+{
+	ERR_FAIL_INDEX_MSG(p_index, buffs.size(), "Buff index out of bounds.");
+
+	Ref<RuntimeBuff> buff;
+
+	/// the wrapper is materialized before the record goes away, only if someone is listening.
+	if (has_connections("buff_removed") || (attribute_container != nullptr && attribute_container->has_connections("buff_removed"))) {
+		buff = get_buff_wrapper(p_index);
+	}
+
+	remove_buff_record(p_index);
+
+	if (buff.is_valid() && has_connections("buff_removed")) {
+		emit_signal("buff_removed", buff);
+	}
+
+	if (attribute_container != nullptr) {
+		attribute_container->_on_buff_removed(this, buff);
+	}
+
+	emit_touched();
+}
+
+void RuntimeAttribute::remove_buff_record(const uint32_t p_index)
+{
+	ERR_FAIL_INDEX_MSG(p_index, buffs.size(), "Buff index out of bounds.");
+
+	if (buffs[p_index].wrapper.is_valid()) {
+		buffs[p_index].wrapper->detach();
+	}
+
+	buffs.remove_at(p_index);
+	refresh_buff_aggregates();
+	mark_changed();
+}
+
+void RuntimeAttribute::refresh_buff_aggregates()
+{
+	if (world != nullptr) {
+		AttributeWorld::Column &column = world->columns[handle];
+		attribute_value_t additive;
+		attribute_value_t multiplier;
+
+		compute_buff_aggregates(additive, multiplier);
+		column.additives.set(world_slot, additive);
+		column.multipliers.set(world_slot, multiplier);
+	}
+}
+
+void RuntimeAttribute::store_values(const attribute_value_t p_previous_value, const attribute_value_t p_value)
+{
+	if (world != nullptr) {
+		AttributeWorld::Column &column = world->columns[handle];
+		column.previous_values.set(world_slot, p_previous_value);
+		column.values.set(world_slot, p_value);
+	} else {
+		previous_value = p_previous_value;
+		value = p_value;
+	}
 }
 
 void RuntimeAttribute::clear_buffs()
 {
+	if (buffs.is_empty()) {
+		return;
+	}
+
+	for (BuffRecord &record : buffs) {
+		if (record.wrapper.is_valid()) {
+			record.wrapper->detach();
+		}
+	}
+
 	buffs.clear();
+	refresh_buff_aggregates();
+	mark_changed();
 }
 
 String RuntimeAttribute::get_attribute_name() const
@@ -907,6 +1653,11 @@ String RuntimeAttribute::get_attribute_name() const
 	return attribute->get_attribute_name();
 }
 
+int RuntimeAttribute::get_handle() const
+{
+	return handle;
+}
+
 TypedArray<RuntimeAttribute> RuntimeAttribute::get_parent_runtime_attributes() const
 {
 	if (const auto derived = get_derived_from(); derived.size() > 0) {
@@ -926,10 +1677,54 @@ TypedArray<RuntimeAttribute> RuntimeAttribute::get_parent_runtime_attributes() c
 	return {};
 }
 
+RuntimeAttribute *RuntimeAttribute::get_parent(const int p_index)
+{
+	ERR_FAIL_NULL_V_MSG(attribute_container, nullptr, "Runtime attribute is not owned by a container, cannot resolve its parents.");
+
+	resolve_parents();
+
+	ERR_FAIL_INDEX_V_MSG(p_index, static_cast<int>(parents.size()), nullptr, "Parent attribute index out of bounds.");
+
+	return parents[p_index];
+}
+
+void RuntimeAttribute::resolve_parents()
+{
+	if (parents_version != attribute_container->attributes_version) {
+		const TypedArray<AttributeBase> derived = get_derived_from();
+
+		parents.clear();
+
+		for (int i = 0; i < derived.size(); i++) {
+			RuntimeAttribute *parent = nullptr;
+
+			if (const Ref<AttributeBase> attribute_base = derived[i]; attribute_base.is_valid()) {
+				if (const Ref<RuntimeAttribute> parent_attribute = attribute_container->get_runtime_attribute_by_name(attribute_base->get_attribute_name()); parent_attribute.is_valid()) {
+					parent = parent_attribute.ptr();
+				}
+			}
+
+			parents.push_back(parent);
+		}
+
+		max_bound = nullptr;
+
+		if (const String max_attribute = attribute->get_max_attribute(); !max_attribute.is_empty() && attribute_set.is_valid()) {
+			if (const Ref<RuntimeAttribute> bound_attribute = attribute_container->get_runtime_attribute_by_handle(attribute_set->resolve_handle(max_attribute)); bound_attribute.is_valid()) {
+				max_bound = bound_attribute.ptr();
+			}
+		}
+
+		parents_version = attribute_container->attributes_version;
+		memo_count = 0;
+		memo_cursor = 0;
+	}
+}
+
 bool RuntimeAttribute::has_buff(const Ref<AttributeBuff> &p_buff) const
 {
-	for (int i = 0; i < buffs.size(); i++) {
-		if (cast_to<RuntimeBuff>(buffs[i])->equals_to(p_buff)) {
+	for (const BuffRecord &record : buffs) {
+		if (record.buff->equals_to(p_buff)) {
 			return true;
 		}
 	}
@@ -939,8 +1734,8 @@ bool RuntimeAttribute::has_buff(const Ref<AttributeBuff> &p_buff) const
 
 bool RuntimeAttribute::has_ongoing_buffs() const
 {
-	for (int i = 0; i < buffs.size(); i++) {
-		if (const Ref<RuntimeBuff> buff = buffs[i]; !buff->can_dequeue() && !Math::is_zero_approx(buff->get_duration())) {
+	for (const BuffRecord &record : buffs) {
+		if (!Math::is_zero_approx(record.time_left) && !Math::is_zero_approx(record.buff->get_duration())) {
 			return true;
 		}
 	}
@@ -949,16 +1744,14 @@ bool RuntimeAttribute::has_ongoing_buffs() const
 }
 bool RuntimeAttribute::is_computable() const
 {
-	return GDVIRTUAL_IS_OVERRIDDEN_PTR(attribute, _compute_value);
+	return attribute->is_natively_computed() || GDVIRTUAL_IS_OVERRIDDEN_PTR(attribute, _compute_value) || attribute->is_bounded();
 }
 
 bool RuntimeAttribute::remove_buff(const Ref<AttributeBuff> &p_buff)
 {
-	for (int i = 0; i < buffs.size(); i++) {
-		if (const Ref<RuntimeBuff> buff = buffs[i]; buff->equals_to(p_buff)) {
-			buffs.remove_at(i);
-			emit_signal("buff_removed", buff);
-			emit_signal("attribute_touched", this, get_buffed_value());
+	for (uint32_t i = 0; i < buffs.size(); i++) {
+		if (buffs[i].buff->equals_to(p_buff)) {
+			remove_buff_at(i);
 			return true;
 		}
 	}
@@ -976,69 +1769,144 @@ Ref<AttributeSet> RuntimeAttribute::get_attribute_set() const
 	return attribute_set;
 }
 
-float RuntimeAttribute::get_buffed_value() const
+attribute_real_t RuntimeAttribute::get_buffed_value() const
 {
-	float add_sub_total = value;
-	float div_mul_multiplier = 1.0f;
+	return to_real(load_buffed_value());
+}
 
-	for (int i = 0; i < buffs.size(); i++) {
-		const Ref<RuntimeBuff> buff = buffs[i];
+TypedArray<AttributeBase> RuntimeAttribute::get_derived_from() const
+{
+	if (attribute_set.is_null() || !attribute_set->frozen) {
+		return compute_derived_from();
+	}
 
-		if (Ref<AttributeBuff> attribute_buff = buff->get_buff(); attribute_buff.is_valid()) {
-			switch (attribute_buff->get_operation()->get_operand()) {
-				case OP_ADD:
-				case OP_SUBTRACT:
-					add_sub_total = attribute_buff->operate(add_sub_total);
-					break;
-				case OP_MULTIPLY:
-				case OP_DIVIDE:
-				case OP_PERCENTAGE:
-					div_mul_multiplier = attribute_buff->operate(div_mul_multiplier);
-					break;
-				default:
-					break;
+	/// a frozen set cannot change, so the dependencies are resolved once and shared by every container.
+	const StringName attribute_name = attribute->get_attribute_name();
+
+	if (const TypedArray<AttributeBase> *cached = attribute_set->derived_from_cache.getptr(attribute_name)) {
+		return *cached;
+	}
+
+	TypedArray<AttributeBase> derived_attributes = compute_derived_from();
+	derived_attributes.make_read_only();
+	attribute_set->derived_from_cache[attribute_name] = derived_attributes;
+
+	return derived_attributes;
+}
+
+TypedArray<AttributeBase> RuntimeAttribute::compute_derived_from() const
+{
+	TypedArray<AttributeBase> derived_attributes;
+
+	if (!GDVIRTUAL_IS_OVERRIDDEN_PTR(attribute, _derived_from) || !GDVIRTUAL_CALL_PTR(attribute, _derived_from, attribute_set, derived_attributes)) {
+		derived_attributes = attribute->get_native_derived_from(attribute_set);
+	}
+
+	/// the bounding attribute is a parent too, so the value is re-clamped when it changes.
+	if (const String max_attribute = attribute->get_max_attribute(); !max_attribute.is_empty() && attribute_set.is_valid()) {
+		for (int i = 0; i < derived_attributes.size(); i++) {
+			if (const Ref<AttributeBase> derived_attribute = derived_attributes[i]; derived_attribute.is_valid() && derived_attribute->get_attribute_name() == max_attribute) {
+				return derived_attributes;
 			}
 		}
+
+		/// a missing bound leaves the attribute unbounded by it, instead of failing the whole attribute.
+		if (const Ref<AttributeBase> bound_attribute = attribute_set->find_by_name(max_attribute); bound_attribute.is_valid()) {
+			derived_attributes.push_back(bound_attribute);
+		} else {
+			WARN_PRINT("Attribute " + attribute->get_attribute_name() + " is bounded by " + max_attribute + ", which does not exist into the AttributeSet. The bound is ignored.");
+		}
 	}
 
-	return add_sub_total * div_mul_multiplier;
+	return derived_attributes;
 }
 
-TypedArray<AttributeBase> RuntimeAttribute::get_derived_from() const
+attribute_real_t RuntimeAttribute::get_previous_value() const
 {
-	if (GDVIRTUAL_IS_OVERRIDDEN_PTR(attribute, _derived_from)) {
-		if (TypedArray<AttributeBase> derived_attributes; GDVIRTUAL_CALL_PTR(attribute, _derived_from, attribute_set, derived_attributes)) {
-			return derived_attributes;
-		}
+	return to_real(load_previous_value());
+}
+
+attribute_real_t RuntimeAttribute::get_value() const
+{
+	return to_real(load_value());
+}
+
+int64_t RuntimeAttribute::get_version() const
+{
+	return static_cast<int64_t>(version);
+}
+
+attribute_value_t RuntimeAttribute::load_buffed_value() const
+{
+	if (world != nullptr) {
+		return world->columns[handle].get_buffed(world_slot);
 	}
 
-	return {};
+	attribute_value_t additive;
+	attribute_value_t multiplier;
+
+	compute_buff_aggregates(additive, multiplier);
+
+	return (value + additive) * multiplier;
+}
+
+attribute_value_t RuntimeAttribute::load_previous_value() const
+{
+	return world != nullptr ? world->columns[handle].previous_values.get(world_slot) : previous_value;
 }
 
-float RuntimeAttribute::get_previous_value() const
+attribute_value_t RuntimeAttribute::load_value() const
 {
-	return previous_value;
+	return world != nullptr ? world->columns[handle].values.get(world_slot) : value;
 }
 
-float RuntimeAttribute::get_value() const
+Ref<RuntimeBuff> RuntimeAttribute::get_buff_by_id(const int p_id) const
 {
-	return value;
+	RuntimeAttribute *self = const_cast<RuntimeAttribute *>(this);
+
+	for (uint32_t i = 0; i < buffs.size(); i++) {
+		if (buffs[i].id == static_cast<uint32_t>(p_id)) {
+			return self->get_buff_wrapper(i);
+		}
+	}
+
+	return {};
 }
 
 TypedArray<RuntimeBuff> RuntimeAttribute::get_buffs() const
 {
-	return buffs;
+	TypedArray<RuntimeBuff> runtime_buffs;
+	RuntimeAttribute *self = const_cast<RuntimeAttribute *>(this);
+
+	for (uint32_t i = 0; i < buffs.size(); i++) {
+		runtime_buffs.push_back(self->get_buff_wrapper(i));
+	}
+
+	return runtime_buffs;
 }
 
 void RuntimeAttribute::set_attribute(const Ref<AttributeBase> &p_value)
 {
 	attribute = p_value;
+	memo_count = 0;
+	memo_cursor = 0;
 }
 
-void RuntimeAttribute::set_value(const float p_value)
+void RuntimeAttribute::set_value(const attribute_real_t p_value)
 {
-	previous_value = value;
-	value = p_value;
+	const attribute_value_t current_value = load_value();
+	const attribute_value_t new_value = attribute.is_valid() && attribute->is_bounded() ? clamp_value(p_value) : attribute_value_t(p_value);
+
+	store_values(current_value, new_value);
+
+	if (!is_equal_value(current_value, new_value)) {
+		mark_changed();
+
+		/// no change signal is emitted, but the derived and bounded attributes follow the write as with every other path.
+		if (attribute_container != nullptr) {
+			attribute_container->notify_derived_attributes(this);
+		}
+	}
 }
 
 void RuntimeAttribute::set_attribute_set(const Ref<AttributeSet> &p_value)
@@ -15,6 +15,10 @@
 #include <godot_cpp/classes/resource.hpp>
 #include <godot_cpp/core/binder_common.hpp>
 #include <godot_cpp/core/gdvirtual.gen.inc>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+#include "attribute_value.hpp"
 
 using namespace godot;
 
@@ -23,6 +27,7 @@ namespace octod::gameplay::attributes
 	class AttributeBase;
 	class AttributeContainer;
 	class AttributeSet;
+	class AttributeWorld;
 	class RuntimeAttribute;
 
 	enum OperationType
@@ -41,6 +46,33 @@ namespace octod::gameplay::attributes
 		OP_SET = 5,
 	};
 
+	/// @brief Applies an operation to a base value.
+	/// @tparam T The value type, see `attribute_value_t`.
+	/// @param p_operand The operation type.
+	/// @param p_base_value The base value to operate on.
+	/// @param p_value The operation value.
+	/// @return The operated value.
+	template <typename T>
+	T operate_value(const OperationType p_operand, const T p_base_value, const T p_value)
+	{
+		switch (p_operand) {
+			case OP_ADD:
+				return p_base_value + p_value;
+			case OP_DIVIDE:
+				return (p_value < T(0) ? -p_value : p_value) < T(0.0001) ? T(0) : p_base_value / p_value;
+			case OP_MULTIPLY:
+				return p_base_value * p_value;
+			case OP_PERCENTAGE:
+				return p_base_value + ((p_base_value / T(100)) * p_value);
+			case OP_SUBTRACT:
+				return p_base_value - p_value;
+			case OP_SET:
+				return p_value;
+			default:
+				return p_base_value;
+		}
+	}
+
 	/// @brief Attribute operation.
 	class AttributeOperation : public Resource
 	{
@@ -53,38 +85,38 @@ namespace octod::gameplay::attributes
 		/// @param p_operand The OperationType instance.
 		/// @param p_value The operation value.
 		/// @return A new instance of AttributeOperation as a Ref.
-		static Ref<AttributeOperation> create(OperationType p_operand, float p_value);
+		static Ref<AttributeOperation> create(OperationType p_operand, attribute_real_t p_value);
 
 		/// @brief Operand.
 		OperationType operand = OP_ADD;
 		/// @brief Value.
-		float value = 0.0f;
+		attribute_value_t value = 0.0f;
 
 	public:
 		/// @brief Returns a new instance of AttributeOperation with the add operation.
 		/// @param p_value The value to add.
 		/// @return The new instance of AttributeOperation.
-		static Ref<AttributeOperation> add(float p_value);
+		static Ref<AttributeOperation> add(attribute_real_t p_value);
 		/// @brief Returns a new instance of AttributeOperation with the divide operation.
 		/// @param p_value The value to divide.
 		/// @return The new instance of AttributeOperation.
-		static Ref<AttributeOperation> divide(float p_value);
+		static Ref<AttributeOperation> divide(attribute_real_t p_value);
 		/// @brief Returns a new instance of AttributeOperation with the multiply operation.
 		/// @param p_value The value to multiply.
 		/// @return The new instance of AttributeOperation.
-		static Ref<AttributeOperation> multiply(float p_value);
+		static Ref<AttributeOperation> multiply(attribute_real_t p_value);
 		/// @brief Returns a new instance of AttributeOperation with the percentage operation.
 		/// @param p_value The percentage value.
 		/// @return The new instance of AttributeOperation.
-		static Ref<AttributeOperation> percentage(float p_value);
+		static Ref<AttributeOperation> percentage(attribute_real_t p_value);
 		/// @brief Returns a new instance of AttributeOperation with the subtract operation.
 		/// @param p_value The value to subtract.
 		/// @return The new instance of AttributeOperation.
-		static Ref<AttributeOperation> subtract(float p_value);
+		static Ref<AttributeOperation> subtract(attribute_real_t p_value);
 		/// @brief Returns a new instance of AttributeOperation with the set operation.
 		/// @param p_value The value to set.
 		/// @return The new instance of AttributeOperation.
-		static Ref<AttributeOperation> forcefully_set_value(float p_value);
+		static Ref<AttributeOperation> forcefully_set_value(attribute_real_t p_value);
 
 		/// @brief Checks for equality
 		[[nodiscard]] bool equals_to(const Ref<AttributeOperation> &other) const;
@@ -94,20 +126,37 @@ namespace octod::gameplay::attributes
 		[[nodiscard]] int get_operand() const;
 		/// @brief Get the value.
 		/// @return The value.
-		[[nodiscard]] float get_value() const;
+		[[nodiscard]] attribute_real_t get_value() const;
 		/// @brief Operate on a base value.
 		/// @param p_base_value The base value to operate on.
-		[[nodiscard]] float operate(float p_base_value) const;
+		[[nodiscard]] attribute_real_t operate(attribute_real_t p_base_value) const;
+		/// @brief Operate on a base value, in the storage type.
+		/// @param p_base_value The base value to operate on.
+		[[nodiscard]] attribute_value_t operate_native(attribute_value_t p_base_value) const;
 		/// @brief Set the operand.
 		void set_operand(int p_value);
 		/// @brief Set the value.
-		void set_value(float p_value);
+		void set_value(attribute_real_t p_value);
 	};
 
 	class AttributeSet : public Resource
 	{
 		GDCLASS(AttributeSet, Resource);
 
+		friend class AttributeBuff;
+		friend class AttributeContainer;
+		friend class RuntimeAttribute;
+
+	public:
+		/// @brief How the AttributeWorld columns of the set store the values.
+		enum StoragePrecision : uint8_t
+		{
+			/// 32-bit floats
+			STORAGE_PRECISION_FULL,
+			/// 16-bit floats, halving the column memory at the cost of precision
+			STORAGE_PRECISION_HALF,
+		};
+
 	protected:
 		/// @brief Bind methods to Godot.
 		static void _bind_methods();
@@ -115,6 +164,18 @@ namespace octod::gameplay::attributes
 		TypedArray<AttributeBase> attributes;
 		/// @brief The set name.
 		String set_name;
+		/// @brief The attribute handles, keyed by attribute name. Rebuilt lazily after the set changes.
+		mutable HashMap<StringName, int> handles;
+		/// @brief If the handles must be rebuilt.
+		mutable bool handles_dirty = true;
+		/// @brief Bumped each time the attributes change, so handle caches can detect stale entries.
+		uint32_t revision = 0;
+		/// @brief If the set is frozen. A frozen set cannot change, so containers share it as is.
+		bool frozen = false;
+		/// @brief The read-only `get_derived_from` results, keyed by attribute name. Filled only while the set is frozen.
+		mutable HashMap<StringName, TypedArray<AttributeBase>> derived_from_cache;
+		/// @brief How the AttributeWorld columns of the set store the values.
+		StoragePrecision storage_precision = STORAGE_PRECISION_FULL;
 
 	public:
 		/// @brief Create an attribute set.
@@ -136,6 +197,8 @@ namespace octod::gameplay::attributes
 		/// @param p_attribute The attribute to find.
 		/// @return The index of the attribute.
 		[[nodiscard]] int find(const Ref<AttributeBase> &p_attribute) const;
+		/// @brief Freezes the set. A frozen set rejects any change and caches the attribute dependencies, so many containers can share it without copies.
+		void freeze();
 		/// @brief Finds an attribute by its own class_name name in the set.
 		/// @param p_classname The class_name name of the attribute.
 		/// @return The attribute.
@@ -159,10 +222,20 @@ namespace octod::gameplay::attributes
 		/// @brief Get the set name.
 		/// @return The set name.
 		[[nodiscard]] String get_set_name() const;
+		/// @brief Gets how the AttributeWorld columns of the set store the values.
+		/// @return The storage precision.
+		[[nodiscard]] int get_storage_precision() const;
+		/// @brief Resolves an attribute name into its handle, a dense index into the set stable until the set changes.
+		/// @param p_name The attribute name.
+		/// @return The attribute handle, -1 if the attribute is not in the set.
+		[[nodiscard]] int resolve_handle(const StringName &p_name) const;
 		/// @brief Check if the set has an attribute.
 		/// @param p_attribute The attribute to check.
 		/// @return True if the set has the attribute, false otherwise.
 		[[nodiscard]] bool has_attribute(const Ref<AttributeBase> &p_attribute) const;
+		/// @brief Returns if the set is frozen.
+		/// @return True if the set is frozen, false otherwise.
+		[[nodiscard]] bool is_frozen() const;
 		/// @brief Remove an attribute from the set.
 		/// @param p_attribute The attribute to remove.
 		/// @return True if the attribute was removed, false otherwise.
@@ -177,6 +250,12 @@ namespace octod::gameplay::attributes
 		/// @brief Set the attributes in the set.
 		/// @param p_attributes The attributes in the set.
 		void set_attributes(const TypedArray<AttributeBase> &p_attributes);
+		/// @brief Sets if the set is frozen. Unfreezing drops the cached attribute dependencies.
+		/// @param p_value True to freeze the set.
+		void set_frozen(bool p_value);
+		/// @brief Sets how the AttributeWorld columns of the set store the values. Applies to worlds without bound containers.
+		/// @param p_value The storage precision.
+		void set_storage_precision(int p_value);
 		/// @brief Set the set name. Sorry for the pun.
 		/// @param p_value The set name.
 		void set_set_name(const String &p_value);
@@ -194,6 +273,8 @@ namespace octod::gameplay::attributes
 		GDVIRTUAL1RC(TypedArray<AttributeBase>, _applies_to, Ref<AttributeSet>); // NOLINT(*-unnecessary-value-param)
 		/// @brief Changes the operation to apply. If overridden, an array of AttributeOperation must be returned. This will skip the operation property.
 		GDVIRTUAL2RC(TypedArray<AttributeOperation>, _operate, TypedArray<float>, Ref<AttributeSet>); // NOLINT(*-unnecessary-value-param)
+		/// @brief Same as `_operate`, without Variant boxing and Resource allocations. Must return an operand and a value per attribute, interleaved. Takes precedence over `_operate`.
+		GDVIRTUAL2RC(PackedFloat32Array, _operate_packed, PackedFloat32Array, Ref<AttributeSet>); // NOLINT(*-unnecessary-value-param)
 
 	protected:
 		/// @brief Bind methods to Godot.
@@ -235,7 +316,11 @@ namespace octod::gameplay::attributes
 		/// @brief Returns the result of the operation on the base value.
 		/// @param base_value The base value to operate on. It is the attribute underlying value.
 		/// @return The result of the operation.
-		[[nodiscard]] float operate(float base_value) const;
+		[[nodiscard]] attribute_real_t operate(attribute_real_t base_value) const;
+		/// @brief Operates on a base value, in the storage type.
+		/// @param p_base_value The base value to operate on.
+		/// @return The operated value.
+		[[nodiscard]] attribute_value_t operate_native(attribute_value_t p_base_value) const;
 		/// @brief Returns the affected attribute name.
 		/// @return The affected attribute name.
 		[[nodiscard]] String get_attribute_name() const;
@@ -251,7 +336,7 @@ namespace octod::gameplay::attributes
 		/// @brief Returns the operation to apply as a Ref.
 		/// @return The operation to apply.
 		[[nodiscard]] Ref<AttributeOperation> get_operation() const;
-		/// @brief Gets the parent buff if this buff was programmatically created because the `_operate` function is overloaded.
+		/// @brief Gets the parent buff, if any. Kept for compatibility: buffs overloading the `_operate` function are applied as is, without creating derived buffs.
 		/// @return The `AttributeBuff` if any, `null` otherwise
 		[[nodiscard]] Ref<AttributeBuff> get_parent_buff() const;
 		/// @brief Returns the maximum number of stacks possible.
@@ -266,9 +351,17 @@ namespace octod::gameplay::attributes
 		/// @brief Returns if the buff is unique.
 		/// @return True if the buff is unique, false otherwise.
 		[[nodiscard]] bool get_unique() const;
-		/// @brief Returns if the _operate method is overridden.
-		/// @return True if the _operate method is overridden, false otherwise.
+		/// @brief Returns if the `_applies_to` results are cached.
+		/// @return True if the targets are static, false otherwise.
+		[[nodiscard]] bool get_static_targets() const;
+		/// @brief Returns if the _operate or the _operate_packed method is overridden.
+		/// @return True if the _operate or the _operate_packed method is overridden, false otherwise.
 		[[nodiscard]] bool is_operate_overridden() const;
+		/// @brief Gets the handles of the attributes returned by `_applies_to` for an attribute set, calling it only once per set while the set does not change.
+		/// @param p_attribute_set The attribute set.
+		/// @param r_handles The attribute handles, copied out of the cache so they stay valid while script runs.
+		/// @return True if the handles were resolved, false if `_applies_to` failed or returned an attribute missing from the set.
+		bool resolve_static_targets(const Ref<AttributeSet> &p_attribute_set, LocalVector<int> &r_handles) const;
 		/// @brief Returns if the buff is time-limited.
 		/// @return True if the buff is time-limited,
 		/// false otherwise.
@@ -297,6 +390,9 @@ namespace octod::gameplay::attributes
 		/// @brief Sets the queue execution.
 		/// @param p_value the queue execution.
 		void set_queue_execution(int p_value);
+		/// @brief Sets if the `_applies_to` results are cached. Clears the cache.
+		/// @param p_value True if the targets are static.
+		void set_static_targets(bool p_value);
 		/// @brief Sets if the buff is transient.
 		/// @param p_value True if the buff is transient, false otherwise.
 		void set_transient(bool p_value);
@@ -332,6 +428,29 @@ namespace octod::gameplay::attributes
 		bool transient = false;
 		/// @brief If the buff is unique and only one can be applied.
 		bool unique = false;
+		/// @brief If `_applies_to` returns the same attributes for a given set, so its results can be cached.
+		bool static_targets = false;
+
+		/// @brief The cached `_applies_to` results of an attribute set.
+		struct StaticTargets
+		{
+			/// @brief The instance id of the attribute set.
+			uint64_t attribute_set_id = 0;
+			/// @brief The attribute set revision the handles were resolved at.
+			uint32_t revision = 0;
+			/// @brief The `static_targets_clock` value of the last lookup, the least recently used entry is evicted first.
+			uint32_t last_used = 0;
+			/// @brief The handles of the target attributes.
+			LocalVector<int> handles;
+		};
+
+		/// @brief The maximum number of attribute sets whose targets are cached. Buffs are usually applied with one shared set, so a few entries are enough.
+		static constexpr uint32_t STATIC_TARGETS_CACHE_SIZE = 4;
+
+		/// @brief The cached `_applies_to` results, one per attribute set the buff was recently applied with.
+		mutable LocalVector<StaticTargets> static_targets_cache;
+		/// @brief Bumped on each cache lookup.
+		mutable uint32_t static_targets_clock = 0;
 	};
 
 	/// @brief Attribute computation argument.
@@ -348,7 +467,7 @@ namespace octod::gameplay::attributes
 		[[nodiscard]] AttributeBuff *get_buff() const;
 
 		/// @brief The operation value.
-		[[nodiscard]] float get_operated_value() const;
+		[[nodiscard]] attribute_real_t get_operated_value() const;
 
 		/// @brief Gets the runtime attribute's parent attributes.
 		[[nodiscard]] TypedArray<RuntimeAttribute> get_parent_attributes() const;
@@ -362,7 +481,7 @@ namespace octod::gameplay::attributes
 
 		/// @brief Set the runtime attribute.
 		/// @param p_value The operation value.
-		void set_operated_value(const float &p_value);
+		void set_operated_value(const attribute_real_t &p_value);
 
 		/// @brief Set the runtime attribute.
 		/// @param p_runtime_attribute The runtime attribute.
@@ -383,7 +502,7 @@ namespace octod::gameplay::attributes
 		AttributeBuff *buff = nullptr;
 
 		/// @brief The runtime attribute operated value. This value is not committed yet.
-		float operated_value = 0.0f;
+		attribute_real_t operated_value = 0.0f;
 
 		/// @brief The runtime attribute.
 		RuntimeAttribute *runtime_attribute = nullptr;
@@ -399,21 +518,98 @@ namespace octod::gameplay::attributes
 		static void _bind_methods();
 		/// @brief The attribute name.
 		String attribute_name;
+		/// @brief The value a runtime attribute starts with.
+		attribute_real_t default_value = 0.0f;
+		/// @brief If `_compute_value` is a pure function of the operated value and the parents buffed values.
+		bool pure = false;
+		/// @brief If the value is clamped to `min_value`.
+		bool use_min_value = false;
+		/// @brief The static minimum value.
+		attribute_real_t min_value = 0.0f;
+		/// @brief If the value is clamped to `max_value`.
+		bool use_max_value = false;
+		/// @brief The static maximum value.
+		attribute_real_t max_value = 0.0f;
+		/// @brief The name of the attribute whose buffed value bounds this attribute value, like MaxHealth for Health.
+		String max_attribute;
 
 	public:
 		/// @brief Get the attribute name.
 		/// @return The attribute name.
 		[[nodiscard]] String get_attribute_name() const;
+		/// @brief Get the value a runtime attribute starts with.
+		/// @return The default value.
+		[[nodiscard]] attribute_real_t get_default_value() const;
+		/// @brief Get the name of the attribute bounding this attribute value.
+		/// @return The bounding attribute name.
+		[[nodiscard]] String get_max_attribute() const;
+		/// @brief Get the static maximum value.
+		/// @return The static maximum value.
+		[[nodiscard]] attribute_real_t get_max_value() const;
+		/// @brief Get the static minimum value.
+		/// @return The static minimum value.
+		[[nodiscard]] attribute_real_t get_min_value() const;
+		/// @brief Get if the value is clamped to `max_value`.
+		/// @return True if the static maximum is used, false otherwise.
+		[[nodiscard]] bool get_use_max_value() const;
+		/// @brief Get if the value is clamped to `min_value`.
+		/// @return True if the static minimum is used, false otherwise.
+		[[nodiscard]] bool get_use_min_value() const;
+		/// @brief Returns if the value has any bound, static or by attribute.
+		/// @return True if the attribute is bounded, false otherwise.
+		[[nodiscard]] bool is_bounded() const;
+		/// @brief Returns if the attribute may depend on other attributes, through `_derived_from`, a native computation or a bounding attribute.
+		/// @return True if the attribute may have parents, false otherwise.
+		[[nodiscard]] bool has_dependencies() const;
+		/// @brief Returns if `_compute_value` is a pure function of the operated value and the parents buffed values.
+		/// @return True if the computation is pure, false otherwise.
+		[[nodiscard]] bool is_pure() const;
 
 		/// @brief Compute the value of the attribute.
-		GDVIRTUAL1RC(float, _compute_value, Ref<AttributeComputationArgument>); // NOLINT(*-unnecessary-value-param)
+		GDVIRTUAL1RC(attribute_real_t, _compute_value, Ref<AttributeComputationArgument>); // NOLINT(*-unnecessary-value-param)
 
 		/// @brief Subscribes to some attributes
 		GDVIRTUAL1RC(TypedArray<AttributeBase>, _derived_from, Ref<AttributeSet>); // NOLINT(*-unnecessary-value-param)
 
+		/// @brief Returns true if the attribute computes its value natively, skipping the `_compute_value` virtual.
+		/// @return True if the attribute is natively computed, false otherwise.
+		[[nodiscard]] virtual bool is_natively_computed() const;
+
+		/// @brief Computes the value of the attribute natively. Called only if `is_natively_computed` returns true.
+		/// @param p_runtime_attribute The runtime attribute being computed.
+		/// @param p_operated_value The operated value. This value is not committed yet.
+		/// @return The computed value.
+		[[nodiscard]] virtual attribute_real_t compute_native_value(RuntimeAttribute *p_runtime_attribute, attribute_real_t p_operated_value) const;
+
+		/// @brief Returns the attributes this attribute derives from when `_derived_from` is not overridden.
+		/// @param p_attribute_set The attribute set to look the attributes up into.
+		/// @return The attributes this attribute derives from.
+		[[nodiscard]] virtual TypedArray<AttributeBase> get_native_derived_from(const Ref<AttributeSet> &p_attribute_set) const;
+
 		/// @brief Set the attribute name.
 		/// @param p_value The attribute name.
 		void set_attribute_name(const String &p_value);
+		/// @brief Set the value a runtime attribute starts with.
+		/// @param p_value The default value.
+		void set_default_value(attribute_real_t p_value);
+		/// @brief Sets if `_compute_value` is a pure function of the operated value and the parents buffed values.
+		/// @param p_value True if the computation is pure, false otherwise.
+		void set_pure(bool p_value);
+		/// @brief Sets the name of the attribute bounding this attribute value.
+		/// @param p_value The bounding attribute name.
+		void set_max_attribute(const String &p_value);
+		/// @brief Sets the static maximum value.
+		/// @param p_value The static maximum value.
+		void set_max_value(attribute_real_t p_value);
+		/// @brief Sets the static minimum value.
+		/// @param p_value The static minimum value.
+		void set_min_value(attribute_real_t p_value);
+		/// @brief Sets if the value is clamped to `max_value`.
+		/// @param p_value True to use the static maximum, false otherwise.
+		void set_use_max_value(bool p_value);
+		/// @brief Sets if the value is clamped to `min_value`.
+		/// @param p_value True to use the static minimum, false otherwise.
+		void set_use_min_value(bool p_value);
 	};
 
 	/// @brief Attribute.
@@ -461,14 +657,20 @@ namespace octod::gameplay::attributes
 		/// @brief Get the duration of the buff.
 		/// @return The duration of the buff.
 		[[nodiscard]] float get_duration() const;
+		/// @brief Get the operation applied to the attribute. For multi-attribute buffs, a new AttributeOperation holding the operation computed for this attribute.
+		/// @return The operation.
+		[[nodiscard]] Ref<AttributeOperation> get_operation() const;
+		/// @brief Get the id of the buff, unique within its runtime attribute while the buff is applied.
+		/// @return The buff id.
+		[[nodiscard]] int get_id() const;
 		/// @brief Get the time left for the buff to expire.
 		/// @return The time left for the buff to expire.
 		[[nodiscard]] float get_time_left() const;
 		/// @brief Returns if the buff has a duration.
 		/// @return True if the buff has a duration, false otherwise.
 		[[nodiscard]] bool has_duration() const;
-		/// @brief Returns if the _operate method is overridden.
-		/// @return True if the _operate method is overridden, false otherwise.
+		/// @brief Returns if the _operate or the _operate_packed method is overridden.
+		/// @return True if the _operate or the _operate_packed method is overridden, false otherwise.
 		[[nodiscard]] bool is_operate_overridden() const;
 		/// @brief Returns if the buff is transient.
 		/// @return True if the buff is transient, false otherwise.
@@ -492,19 +694,29 @@ namespace octod::gameplay::attributes
 
 		/// @brief The attribute buff reference.
 		Ref<AttributeBuff> buff;
-		/// @brief The time the buff was added.
+		/// @brief The time left, used when the wrapper is detached from its record.
 		float time_left = 0.0f;
 		/// @brief If the buff is unique.
 		bool unique = false;
+		/// @brief The runtime attribute owning the wrapped buff record, nullptr once detached.
+		RuntimeAttribute *owner = nullptr;
+		/// @brief The id of the wrapped buff record.
+		uint32_t record_id = 0;
+
+		/// @brief Detaches the wrapper from its record, copying the record state.
+		void detach();
+		/// @brief Gets the wrapped time left storage.
+		/// @return The record time left if attached, the wrapper one otherwise.
+		[[nodiscard]] float &time_left_cell();
 
 		/// @brief Returns the attributes the buff applies to.
 		/// @param p_attribute_container The attribute container set to check.
 		/// @return The attributes the buff applies to.
-		Ref<RuntimeAttribute> applies_to(const AttributeContainer *p_attribute_container) const;
+		Ref<RuntimeAttribute> applies_to(AttributeContainer *p_attribute_container) const;
 		/// @brief Operate on the runtime attributes.
 		/// @param p_runtime_attributes The runtime attributes to operate on.
 		/// @return The operated runtime values.
-		[[nodiscard]] float operate(const Ref<RuntimeAttribute> &p_runtime_attributes) const;
+		[[nodiscard]] attribute_real_t operate(const Ref<RuntimeAttribute> &p_runtime_attributes) const;
 	};
 
 	class RuntimeAttribute : public RefCounted
@@ -512,6 +724,9 @@ namespace octod::gameplay::attributes
 		GDCLASS(RuntimeAttribute, RefCounted);
 
 	public:
+		/// @brief Detaches the materialized buff wrappers, which may outlive the attribute.
+		~RuntimeAttribute() override;
+
 		/// @brief Add a buff to the attribute.
 		/// @param p_buff The buff to add.
 		/// @return True if the buff was added, false otherwise.
@@ -532,10 +747,19 @@ namespace octod::gameplay::attributes
 		/// @return The attribute name
 		[[nodiscard]] String get_attribute_name() const;
 
+		/// @brief Gets the attribute handle in its container attribute set.
+		/// @return The attribute handle, -1 if the attribute is not in the set.
+		[[nodiscard]] int get_handle() const;
+
 		/// @brief Get the parent runtime attributes.
 		/// @return An array of runtime attributes.
 		[[nodiscard]] TypedArray<RuntimeAttribute> get_parent_runtime_attributes() const;
 
+		/// @brief Gets a parent runtime attribute by its index in `get_derived_from`, without going through the script layer.
+		/// @param p_index The parent index.
+		/// @return The parent runtime attribute, nullptr if it is not in the container.
+		[[nodiscard]] RuntimeAttribute *get_parent(int p_index);
+
 		/// @brief Check if the attribute has a buff.
 		/// @param p_buff The buff to check.
 		/// @return True if the attribute has the buff, false otherwise.
@@ -546,7 +770,7 @@ namespace octod::gameplay::attributes
 		[[nodiscard]] bool has_ongoing_buffs() const;
 
 		/// @brief Check if the attribute is computable.
-		/// @return True if the attribute _compute_value is overridden.
+		/// @return True if the attribute is natively computed, overrides _compute_value or is bounded.
 		[[nodiscard]] bool is_computable() const;
 
 		/// @brief Remove a buff from the attribute.
@@ -564,7 +788,7 @@ namespace octod::gameplay::attributes
 
 		/// @brief Get the buffed value of the attribute.
 		/// @return The buffed value.
-		[[nodiscard]] float get_buffed_value() const;
+		[[nodiscard]] attribute_real_t get_buffed_value() const;
 
 		/// @brief Get the attributes the attribute derives from.
 		/// @return The attributes the attribute derives from.
@@ -572,15 +796,24 @@ namespace octod::gameplay::attributes
 
 		/// @brief Get the previous value of the attribute.
 		/// @return The previous value of the attribute.
-		[[nodiscard]] float get_previous_value() const;
+		[[nodiscard]] attribute_real_t get_previous_value() const;
 
 		/// @brief Gets the value of the attribute.
 		/// @return The value of the attribute.
-		[[nodiscard]] float get_value() const;
+		[[nodiscard]] attribute_real_t get_value() const;
+
+		/// @brief Gets the version of the attribute, bumped each time its value or its buffs change.
+		/// @return The version.
+		[[nodiscard]] int64_t get_version() const;
 
 		/// @brief Get the buffs affecting the attribute.
 		[[nodiscard]] TypedArray<RuntimeBuff> get_buffs() const;
 
+		/// @brief Get an applied buff by its id, see `RuntimeBuff::get_id`.
+		/// @param p_id The buff id.
+		/// @return The buff, null if no applied buff has the id.
+		[[nodiscard]] Ref<RuntimeBuff> get_buff_by_id(int p_id) const;
+
 		/// @brief Set the attribute.
 		/// @param p_value The attribute.
 		void set_attribute(const Ref<AttributeBase> &p_value);
@@ -589,32 +822,187 @@ namespace octod::gameplay::attributes
 		/// @param p_value The attribute set.
 		void set_attribute_set(const Ref<AttributeSet> &p_value);
 
-		/// @brief Sets the value of the attribute.
+		/// @brief Sets the value of the attribute. The derived attributes are recomputed, no change signal is emitted.
 		/// @param p_value The value of the attribute.
-		void set_value(float p_value);
+		void set_value(attribute_real_t p_value);
 
 	protected:
 		friend class AttributeContainer;
+		friend class AttributePrototype;
+		friend class AttributeWorld;
 		friend class RuntimeBuff;
 
+		/// @brief An operation replacing the buff one, computed for each target by a multi-attribute buff `_operate`.
+		struct OperationOverride
+		{
+			/// @brief The operation type.
+			OperationType operand = OP_ADD;
+			/// @brief The operation value.
+			attribute_value_t value = 0.0f;
+		};
+
+		/// @brief A buff applied to the attribute. Kept natively, the RuntimeBuff wrapper is created only when scripts ask for it.
+		struct BuffRecord
+		{
+			/// @brief The buff definition. For multi-attribute buffs, the applied buff itself, shared by all the targets.
+			Ref<AttributeBuff> buff;
+			/// @brief The time left before the buff expires.
+			float time_left = 0.0f;
+			/// @brief The record id, stable while the record lives.
+			uint32_t id = 0;
+			/// @brief If the record uses `operation` instead of the buff operation.
+			bool overridden = false;
+			/// @brief The operation of a multi-attribute buff for this attribute, used if `overridden`.
+			OperationOverride operation;
+			/// @brief The materialized wrapper, if any.
+			Ref<RuntimeBuff> wrapper;
+
+			/// @brief Gets the operation type of the record.
+			/// @return The operation type.
+			[[nodiscard]] OperationType get_operand() const
+			{
+				return overridden ? operation.operand : static_cast<OperationType>(buff->get_operation()->get_operand());
+			}
+
+			/// @brief Operates on a base value with the record operation.
+			/// @param p_base_value The base value.
+			/// @return The operated value.
+			[[nodiscard]] attribute_value_t operate(const attribute_value_t p_base_value) const
+			{
+				return overridden ? operate_value(operation.operand, p_base_value, operation.value) : buff->operate_native(p_base_value);
+			}
+		};
+
 		static void _bind_methods();
+		/// @brief Computes the attributes the attribute derives from, bypassing the frozen set cache.
+		/// @return The attributes the attribute derives from.
+		[[nodiscard]] TypedArray<AttributeBase> compute_derived_from() const;
+		/// @brief Calls the `_compute_value` virtual, going through the memo if the attribute is pure.
+		/// @param p_buff The buff being applied, nullptr if none.
+		/// @param p_operated_value The operated value.
+		/// @return The computed value.
+		attribute_real_t call_compute_value(AttributeBuff *p_buff, attribute_real_t p_operated_value);
+		/// @brief Clamps a value to the attribute bounds.
+		/// @param p_value The value to clamp.
+		/// @return The clamped value.
+		attribute_value_t clamp_value(attribute_value_t p_value);
+		/// @brief Commits a new value, emitting the change signals if it differs from the current one.
+		/// @param p_value The new value.
+		void commit_value(attribute_value_t p_value);
+		/// @brief Resolves the parent runtime attributes if the container attributes changed since the last resolution.
+		void resolve_parents();
+		/// @brief Binds the attribute to a world slot, moving its values into the world columns.
+		/// @param p_world The world.
+		/// @param p_slot The container slot.
+		void bind_world(AttributeWorld *p_world, uint32_t p_slot);
+		/// @brief Unbinds the attribute from its world, moving its values back.
+		void unbind_world();
+		/// @brief Folds the buffs into an additive term and a multiplier, so the buffed value is `(value + additive) * multiplier`.
+		/// @param r_additive The sum of the add and subtract buffs.
+		/// @param r_multiplier The product of the multiply, divide and percentage buffs.
+		void compute_buff_aggregates(attribute_value_t &r_additive, attribute_value_t &r_multiplier) const;
+		/// @brief Refreshes the world buff aggregates after the buffs changed. Does nothing if not bound to a world.
+		void refresh_buff_aggregates();
+		/// @brief Gets a blank RuntimeBuff, recycled from the container pool if any.
+		/// @return The RuntimeBuff.
+		[[nodiscard]] Ref<RuntimeBuff> acquire_runtime_buff() const;
+		/// @brief Emits a buff signal, materializing the buff wrapper only if the signal has listeners.
+		/// @param p_signal The signal name.
+		/// @param p_index The buff record index.
+		void emit_buff_signal(const StringName &p_signal, uint32_t p_index);
+		/// @brief Notifies the owner container, then the listeners, that the value changed.
+		/// @param p_previous_value The previous value.
+		/// @param p_new_value The new value.
+		void notify_value_changed(attribute_value_t p_previous_value, attribute_value_t p_new_value);
+		/// @brief Emits `attribute_touched` with the buffed value, computing it only if the signal has listeners.
+		void emit_touched();
+		/// @brief Bumps the version and journals the change in the owner container.
+		void mark_changed();
+		/// @brief Finds a buff record by id.
+		/// @param p_id The record id.
+		/// @return The record, nullptr if it was removed.
+		[[nodiscard]] BuffRecord *find_buff_record(uint32_t p_id);
+		/// @brief Finds the index of a buff record by id. Listeners may add or remove buffs, so indices are looked up again after each emission.
+		/// @param p_id The record id.
+		/// @return The record index, -1 if it was removed.
+		[[nodiscard]] int find_buff_index(uint32_t p_id) const;
+		/// @brief Gets the RuntimeBuff wrapper of a buff record, creating it on first use.
+		/// @param p_index The buff record index.
+		/// @return The wrapper.
+		Ref<RuntimeBuff> get_buff_wrapper(uint32_t p_index);
+		/// @brief Adds a buff without creating a RuntimeBuff wrapper.
+		/// @param p_buff The buff to add.
+		/// @param r_index The index of the stored or merged buff record, -1 if the buff was not stored (non transient).
+		/// @param p_override The operation replacing the buff one, nullptr to use the buff operation. If set, the buff attribute name is not checked.
+		/// @return True if the attribute received the buff, false otherwise.
+		bool push_buff(const Ref<AttributeBuff> &p_buff, int &r_index, const OperationOverride *p_override = nullptr);
+		/// @brief Checks the unique and stack size constraints of a buff.
+		/// @param p_buff The buff to check.
+		/// @return True if another instance of the buff can be stored, false otherwise.
+		[[nodiscard]] bool can_stack_buff(const Ref<AttributeBuff> &p_buff) const;
+		/// @brief Removes a buff record, notifying the listeners.
+		/// @param p_index The buff record index.
+		void remove_buff_at(uint32_t p_index);
+		/// @brief Removes a buff record, detaching its wrapper.
+		/// @param p_index The buff record index.
+		void remove_buff_record(uint32_t p_index);
+		/// @brief Gets the buffed value in the storage type.
+		/// @return The buffed value.
+		[[nodiscard]] attribute_value_t load_buffed_value() const;
+		/// @brief Gets the previous value in the storage type.
+		/// @return The previous value.
+		[[nodiscard]] attribute_value_t load_previous_value() const;
+		/// @brief Gets the value in the storage type.
+		/// @return The value.
+		[[nodiscard]] attribute_value_t load_value() const;
+		/// @brief Stores the values, in the world columns if bound to a world.
+		/// @param p_previous_value The previous value.
+		/// @param p_value The value.
+		void store_values(attribute_value_t p_previous_value, attribute_value_t p_value);
 		/// @brief The attribute reference.
 		Ref<AttributeBase> attribute;
 		/// @brief The attribute set reference.
 		Ref<AttributeSet> attribute_set;
 		/// @brief The attribute container reference.
-		AttributeContainer *attribute_container;
-		/// @brief The previous value of the attribute.
-		float previous_value = 0.0f;
-		/// @brief The attribute value.
-		float value = 0.0f;
+		AttributeContainer *attribute_container = nullptr;
+		/// @brief The attribute handle in the container attribute set.
+		int handle = -1;
+		/// @brief The previous value of the attribute, used when not bound to a world.
+		attribute_value_t previous_value = 0.0f;
+		/// @brief The attribute value, used when not bound to a world.
+		attribute_value_t value = 0.0f;
+		/// @brief The world storing the attribute values, nullptr if the values are stored here.
+		AttributeWorld *world = nullptr;
+		/// @brief The container slot in the world.
+		uint32_t world_slot = 0;
 		/// @brief The attribute buffs.
-		TypedArray<RuntimeBuff> buffs;
+		LocalVector<BuffRecord> buffs;
+		/// @brief The id given to the next buff record.
+		uint32_t next_buff_id = 1;
+		/// @brief Bumped each time the value or the buffs change.
+		uint64_t version = 0;
+		/// @brief The parent runtime attributes, in `get_derived_from` order. Missing parents are stored as nullptr.
+		LocalVector<RuntimeAttribute *> parents;
+		/// @brief The container attributes version the parents were resolved against.
+		uint32_t parents_version = 0;
+		/// @brief The runtime attribute named by `max_attribute`, resolved along with the parents.
+		RuntimeAttribute *max_bound = nullptr;
+		/// @brief The number of computations memoized for pure attributes.
+		static constexpr uint32_t MEMO_SIZE = 4;
+		/// @brief The memoized inputs, MEMO_SIZE rows of the operated value followed by the parents buffed values, plus one row for the current key.
+		LocalVector<attribute_real_t> memo_inputs;
+		/// @brief The memoized results, one per memo row.
+		attribute_real_t memo_results[MEMO_SIZE] = {};
+		/// @brief The number of valid memo rows.
+		uint32_t memo_count = 0;
+		/// @brief The next memo row to overwrite.
+		uint32_t memo_cursor = 0;
 	};
 } //namespace octod::gameplay::attributes
 
 VARIANT_ENUM_CAST(octod::gameplay::attributes::AttributeBuff::QueueExecution);
 VARIANT_ENUM_CAST(octod::gameplay::attributes::AttributeBuff::DurationMerging);
 VARIANT_ENUM_CAST(octod::gameplay::attributes::OperationType);
+VARIANT_ENUM_CAST(octod::gameplay::attributes::AttributeSet::StoragePrecision);
 
 #endif
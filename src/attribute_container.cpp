@@ -11,6 +11,9 @@
 #include "attribute_container.hpp"
 
 #include "attribute.hpp"
+#include "attribute_prototype.hpp"
+#include "attribute_world.hpp"
+#include "derived_attributes.hpp"
 #include "godot_cpp/classes/wrapped.hpp"
 
 using namespace octod::gameplay::attributes;
@@ -23,96 +26,241 @@ void AttributeContainer::_notification(const int p_what)
 		}
 		set_physics_process(true);
 	} else if (p_what == NOTIFICATION_PHYSICS_PROCESS && !manual_ticking) {
-		const TypedArray<RuntimeAttribute> &runtime_attributes = attributes.values();
-		const float phy_time = static_cast<float>(get_physics_process_delta_time());
+		subtract_attribute_buffs_ticks(static_cast<float>(get_physics_process_delta_time()));
+	} else if (p_what == NOTIFICATION_PREDELETE) {
+		unbind_world();
+		clear_attributes();
+	}
+}
 
-		for (int64_t i = 0; i < runtime_attributes.size(); i++) {
-			const Ref<RuntimeAttribute> &attribute = runtime_attributes[i];
+void AttributeContainer::_on_attribute_changed(RuntimeAttribute *p_attribute, const attribute_value_t p_previous_value, const attribute_value_t p_new_value)
+{
+	/// attributes outside of the attribute set have no handle to report, their changes are emitted as they happen.
+	if (coalesce_changes && p_attribute->handle >= 0) {
+		queue_change(p_attribute, p_previous_value, p_new_value);
+	} else if (has_connections("attribute_changed")) {
+		emit_signal("attribute_changed", p_attribute, to_real(p_previous_value), to_real(p_new_value));
+	}
 
-			if (!attribute.is_valid()) {
-				continue;
-			}
+	notify_derived_attributes(p_attribute);
+}
 
-			TypedArray<RuntimeBuff> buffs = attribute->get_buffs();
-
-			for (int64_t j = buffs.size() - 1; j >= 0; j--) {
-				if (const Ref<RuntimeBuff> &buff = buffs[j]; buff.is_valid() && buff->is_transient_time_based()) {
-					/// check if the buff needs a waterfall or parallel execution.
-					/// for the latter, keep the code as it is
-					/// for the first, check if another buff of the same
-					/// type exists in the queue and,
-					/// if present, avoid setting the time left.
-					if (buff->get_buff()->get_queue_execution() == AttributeBuff::QueueExecution::QUEUE_EXECUTION_WATERFALL) {
-						bool should_skip = false;
-
-						/// we act as a fifo, so let's see if there are other buffs applied before the current one.
-						for (int64_t k = j - 1; k >= 0; k--) {
-							if (const Ref<RuntimeBuff> other_buff = buffs[k]; other_buff->equals_to(buff->buff)) {
-								should_skip = true;
-								break;
-							}
-						}
-
-						if (should_skip) {
-							continue;
-						}
-					}
+void AttributeContainer::_on_buff_applied(RuntimeAttribute *p_attribute, const uint32_t p_id)
+{
+	/// the attribute listeners ran first and may have removed the buff.
+	if (const int index = p_attribute->find_buff_index(p_id); index >= 0 && has_connections("buff_applied")) {
+		emit_signal("buff_applied", p_attribute->get_buff_wrapper(index));
+	}
 
-					buff->set_time_left(buff->get_time_left() - phy_time);
+	notify_derived_attributes(p_attribute);
+}
 
-					emit_signal("buff_time_elapsed", buff);
+void AttributeContainer::_on_buff_removed(RuntimeAttribute *p_attribute, const Ref<RuntimeBuff> &p_buff)
+{
+	if (p_buff.is_valid() && has_connections("buff_removed")) {
+		emit_signal("buff_removed", p_buff);
+	}
 
-					if (buff->can_dequeue()) {
-						emit_signal("buff_dequeued", buff);
-						remove_buff(buff->buff);
-					}
-				}
-			}
+	notify_derived_attributes(p_attribute);
+}
+
+void AttributeContainer::_on_buff_time_updated(RuntimeAttribute *p_attribute, const uint32_t p_id)
+{
+	if (const int index = p_attribute->find_buff_index(p_id); index >= 0 && has_connections("buff_time_updated")) {
+		emit_signal("buff_time_updated", p_attribute->get_buff_wrapper(index));
+	}
+}
+
+attribute_real_t AttributeContainer::get_default_value(const int p_handle) const
+{
+	if (attribute_set.is_null()) {
+		return 0.0f;
+	}
+
+	const Ref<AttributeBase> attribute = attribute_set->get_at(p_handle);
+
+	return attribute.is_valid() ? attribute->get_default_value() : 0.0f;
+}
+
+RuntimeAttribute *AttributeContainer::materialize_attribute(const int p_handle)
+{
+	if (p_handle < 0 || static_cast<uint32_t>(p_handle) >= handles.size()) {
+		return nullptr;
+	}
+
+	if (handles[p_handle] == nullptr && sparse && attribute_set.is_valid()) {
+		if (const Ref<AttributeBase> attribute = attribute_set->get_at(p_handle); attribute.is_valid()) {
+			add_attribute(attribute);
 		}
 	}
+
+	return handles[p_handle];
 }
 
-void AttributeContainer::_on_attribute_changed(const Ref<RuntimeAttribute> &p_attribute, const float p_previous_value, const float p_new_value)
+void AttributeContainer::push_operated_buff(RuntimeAttribute *p_attribute, const Ref<AttributeBuff> &p_buff, const int p_operand, const attribute_value_t p_value)
 {
-	emit_signal("attribute_changed", p_attribute, p_previous_value, p_new_value);
-	notify_derived_attributes(p_attribute);
+	RuntimeAttribute::OperationOverride operation;
+
+	operation.operand = static_cast<OperationType>(p_operand);
+	operation.value = p_value;
+
+	if (int index; p_attribute->push_buff(p_buff, index, &operation) && index >= 0 && !Math::is_zero_approx(p_buff->get_duration()) && has_connections("buff_enqueued")) {
+		emit_signal("buff_enqueued", p_attribute->get_buff_wrapper(index));
+	}
 }
 
-void AttributeContainer::_on_buff_applied(RuntimeBuff *p_buff)
+void AttributeContainer::bind_world()
 {
-	emit_signal("buff_applied", Ref(p_buff));
+	if (world.is_null() || world_bound) {
+		return;
+	}
 
-	if (const auto attribute = get_runtime_attribute_by_name(p_buff->get_attribute_name()); attribute.is_valid()) {
-		notify_derived_attributes(attribute);
+	if (world->attribute_set.is_null()) {
+		world->set_attribute_set(attribute_set);
 	}
+
+	ERR_FAIL_COND_MSG(world->attribute_set != attribute_set, "The AttributeWorld and the container must share the same AttributeSet, the values are stored in the container.");
+
+	world_slot = world->register_container(this);
+	world_bound = true;
 }
 
-void AttributeContainer::_on_buff_removed(const Ref<RuntimeBuff> &p_buff)
+void AttributeContainer::unbind_world()
 {
-	emit_signal("buff_removed", p_buff);
+	if (!world_bound) {
+		return;
+	}
 
-	if (const auto attribute = get_runtime_attribute_by_name(p_buff->get_attribute_name()); attribute.is_valid() && !attribute.is_null()) {
-		notify_derived_attributes(attribute);
+	for (RuntimeAttribute *runtime_attribute : ordered_attributes) {
+		runtime_attribute->unbind_world();
 	}
+
+	world->unregister_container(world_slot);
+	world_bound = false;
 }
 
-void AttributeContainer::_on_buff_time_updated(const Ref<RuntimeBuff> &p_buff)
+void AttributeContainer::clear_attributes()
 {
-	emit_signal("buff_time_updated", p_buff);
+	for (RuntimeAttribute *runtime_attribute : ordered_attributes) {
+		runtime_attribute->attribute_container = nullptr;
+	}
+
+	attributes.clear();
+	ordered_attributes.clear();
+	derived_attributes.clear();
+	handles.clear();
+	attributes_version++;
+	clear_pending_changes();
+	version++;
+	reset_journal();
+}
+
+void AttributeContainer::clear_pending_changes()
+{
+	for (const PendingChange &change : pending_changes) {
+		pending_change_slots[change.handle] = -1;
+	}
+
+	pending_changes.clear();
+	pending_buffs.clear();
+	pending_buff_keys.clear();
+}
+
+void AttributeContainer::record_change(const RuntimeAttribute *p_attribute)
+{
+	version++;
+
+	/// attributes outside of the attribute set have no handle to journal.
+	if (p_attribute->handle < 0) {
+		return;
+	}
+
+	if (journal_capacity <= 0) {
+		journal_floor = version;
+		return;
+	}
+
+	/// consecutive changes of the same attribute share an entry.
+	if (!journal.is_empty()) {
+		if (JournalEntry &last = journal[(journal_head + journal.size() - 1) % journal.size()]; last.handle == p_attribute->handle) {
+			last.version = version;
+			return;
+		}
+	}
+
+	if (journal.size() < static_cast<uint32_t>(journal_capacity)) {
+		journal.push_back({ version, p_attribute->handle });
+	} else {
+		journal_floor = journal[journal_head].version;
+		journal[journal_head] = { version, p_attribute->handle };
+		journal_head = (journal_head + 1) % journal.size();
+	}
+}
+
+void AttributeContainer::reset_journal()
+{
+	journal.clear();
+	journal_head = 0;
+	journal_floor = version;
+}
+
+void AttributeContainer::queue_buff_change(const RuntimeAttribute *p_attribute, const uint32_t p_index)
+{
+	const uint64_t key = (static_cast<uint64_t>(p_attribute->handle) << 32) | p_attribute->buffs[p_index].id;
+
+	if (!pending_buff_keys.has(key)) {
+		pending_buff_keys.insert(key);
+		pending_buffs.push_back(key);
+	}
+
+	schedule_flush();
+}
+
+void AttributeContainer::queue_change(const RuntimeAttribute *p_attribute, const attribute_value_t p_previous_value, const attribute_value_t p_new_value)
+{
+	const int handle = p_attribute->handle;
+
+	if (static_cast<uint32_t>(handle) >= pending_change_slots.size()) {
+		const uint32_t size = pending_change_slots.size();
+		pending_change_slots.resize(handle + 1);
+
+		for (uint32_t i = size; i < pending_change_slots.size(); i++) {
+			pending_change_slots[i] = -1;
+		}
+	}
+
+	/// the first previous value of the frame is kept, so the emitted pair spans the whole frame.
+	if (const int slot = pending_change_slots[handle]; slot >= 0) {
+		pending_changes[slot].value = p_new_value;
+	} else {
+		pending_change_slots[handle] = static_cast<int>(pending_changes.size());
+		pending_changes.push_back({ handle, p_previous_value, p_new_value });
+	}
+
+	schedule_flush();
+}
+
+void AttributeContainer::schedule_flush()
+{
+	if (!flush_scheduled) {
+		flush_scheduled = true;
+		call_deferred("flush_changes");
+	}
 }
 
 bool AttributeContainer::has_attribute(const Ref<AttributeBase> &p_attribute) const
 {
-	return attributes.has(p_attribute->get_attribute_name());
+	if (attributes.has(p_attribute->get_attribute_name())) {
+		return true;
+	}
+
+	return sparse && attribute_set.is_valid() && attribute_set->resolve_handle(p_attribute->get_attribute_name()) >= 0;
 }
 
 void AttributeContainer::notify_derived_attributes(const Ref<RuntimeAttribute> &p_base_runtime_attribute)
 {
-	if (derived_attributes.has(p_base_runtime_attribute->get_attribute()->get_attribute_name())) {
-		TypedArray<RuntimeAttribute> derived = derived_attributes[p_base_runtime_attribute->get_attribute()->get_attribute_name()];
-
-		for (int i = 0; i < derived.size(); i++) {
-			const Ref<RuntimeAttribute> derived_attribute = derived[i];
+	if (const LocalVector<Ref<RuntimeAttribute>> *derived = derived_attributes.getptr(p_base_runtime_attribute->get_attribute()->get_attribute_name())) {
+		for (const Ref<RuntimeAttribute> &derived_attribute : *derived) {
 			derived_attribute->compute_value();
 		}
 	}
@@ -121,50 +269,66 @@ void AttributeContainer::notify_derived_attributes(const Ref<RuntimeAttribute> &
 void AttributeContainer::add_attribute(const Ref<AttributeBase> &p_attribute)
 {
 	ERR_FAIL_NULL_MSG(p_attribute, "Attribute cannot be null, it must be an instance of a class inheriting from AttributeBase abstract class.");
-	ERR_FAIL_COND_MSG(has_attribute(p_attribute), "Attribute already exists in the container.");
-
-	RuntimeAttribute *runtime_attribute = memnew(RuntimeAttribute);
+	ERR_FAIL_COND_MSG(attributes.has(p_attribute->get_attribute_name()), "Attribute already exists in the container.");
 
 	if (attribute_set.is_null()) {
 		attribute_set.instantiate();
 	}
 
 	if (!attribute_set->has_attribute(p_attribute)) {
+		ERR_FAIL_COND_MSG(attribute_set->is_frozen(), "Cannot add an attribute missing from a frozen AttributeSet.");
+
 		attribute_set->add_attribute(p_attribute);
 	}
 
+	/// held by a Ref from the start, so it is released if a check below fails.
+	Ref<RuntimeAttribute> runtime_attribute;
+	runtime_attribute.instantiate();
+
 	runtime_attribute->attribute_container = this;
 	runtime_attribute->set_attribute(p_attribute);
 	runtime_attribute->set_attribute_set(attribute_set);
+	runtime_attribute->value = p_attribute->get_default_value();
+	runtime_attribute->previous_value = runtime_attribute->value;
+
+	const TypedArray<AttributeBase> base_attributes = runtime_attribute->get_derived_from();
 
-	if (TypedArray<AttributeBase> base_attributes = runtime_attribute->get_derived_from(); base_attributes.size() > 0) {
-		for (int i = 0; i < base_attributes.size(); i++) {
-			const Ref<AttributeBase> base_attribute = base_attributes[i];
+	/// every base attribute is checked before registering anything, so a missing one leaves no trace in the container.
+	for (int i = 0; i < base_attributes.size(); i++) {
+		const Ref<AttributeBase> base_attribute = base_attributes[i];
+		ERR_FAIL_COND_MSG(base_attribute.is_null(), "A base attribute of " + p_attribute->get_attribute_name() + " does not exist into the AttributeSet.");
+	}
 
-			ERR_FAIL_COND_MSG(base_attribute.is_null(), "Required base attribute " + p_attribute->get_attribute_name() + " does not exist into the AttributeSet.");
+	for (int i = 0; i < base_attributes.size(); i++) {
+		const Ref<AttributeBase> base_attribute = base_attributes[i];
+		derived_attributes[base_attribute->get_attribute_name()].push_back(runtime_attribute);
+	}
 
-			if (derived_attributes.has(base_attribute->get_attribute_name())) {
-				Array _derived = derived_attributes[base_attribute->get_attribute_name()];
-				_derived.push_back(runtime_attribute);
-			} else {
-				Array _derived;
-				derived_attributes[base_attribute->get_attribute_name()] = _derived;
-				_derived.push_back(runtime_attribute);
+	/// value and buff events reach the container through direct calls, see RuntimeAttribute::notify_value_changed.
+	attributes[p_attribute->get_attribute_name()] = runtime_attribute;
+	ordered_attributes.push_back(runtime_attribute.ptr());
+
+	if (const int handle = attribute_set->resolve_handle(p_attribute->get_attribute_name()); handle >= 0) {
+		if (static_cast<uint32_t>(handle) >= handles.size()) {
+			const uint32_t previous_size = handles.size();
+
+			handles.resize(handle + 1);
+
+			for (uint32_t i = previous_size; i < handles.size(); i++) {
+				handles[i] = nullptr;
 			}
 		}
-	}
 
-	const Callable attribute_changed_callable = Callable::create(this, "_on_attribute_changed");
-	const Callable buff_applied_callable = Callable::create(this, "_on_buff_applied");
-	const Callable buff_removed_callable = Callable::create(this, "_on_buff_removed");
-	const Callable buff_time_updated_callable = Callable::create(this, "_on_buff_time_updated");
+		handles[handle] = runtime_attribute.ptr();
+		runtime_attribute->handle = handle;
 
-	runtime_attribute->connect("attribute_changed", attribute_changed_callable);
-	runtime_attribute->connect("buff_added", buff_applied_callable);
-	runtime_attribute->connect("buff_removed", buff_removed_callable);
-	runtime_attribute->connect("buff_time_updated", buff_time_updated_callable);
+		if (world_bound) {
+			runtime_attribute->bind_world(world.ptr(), world_slot);
+		}
+	}
 
-	attributes[p_attribute->get_attribute_name()] = runtime_attribute;
+	attributes_version++;
+	record_change(runtime_attribute.ptr());
 }
 
 void AttributeContainer::apply_buff(const Ref<AttributeBuff> &p_buff)
@@ -172,60 +336,249 @@ void AttributeContainer::apply_buff(const Ref<AttributeBuff> &p_buff)
 	ERR_FAIL_NULL_MSG(p_buff, "Buff cannot be null, it must be an instance of a class inheriting from AttributeBuff abstract class.");
 
 	if (p_buff->is_operate_overridden()) {
+		/// the affected attributes go in the container scratch buffer, which keeps its capacity between calls.
+		/// listeners applying another buff while this one is being applied get their own buffer.
+		if (scratch_in_use) {
+			LocalVector<int> target_handles;
+			LocalVector<Ref<RuntimeAttribute>> targets;
+			apply_operated_buff(p_buff, target_handles, targets);
+			return;
+		}
+
+		scratch_in_use = true;
+		apply_operated_buff(p_buff, scratch_handles, scratch_attributes);
+		scratch_attributes.clear();
+		scratch_in_use = false;
+	} else {
+		const Ref<RuntimeAttribute> runtime_attribute = get_runtime_attribute_by_name(p_buff->get_attribute_name());
+
+		ERR_FAIL_COND_MSG(!runtime_attribute.is_valid(), "Attribute '" + p_buff->get_attribute_name() + "' not found in the container.");
+		ERR_FAIL_COND_MSG(runtime_attribute.is_null(), "Attribute reference is not valid.");
+
+		if (int index; runtime_attribute->push_buff(p_buff, index) && index >= 0 && !Math::is_zero_approx(p_buff->get_duration()) && has_connections("buff_enqueued")) {
+			emit_signal("buff_enqueued", runtime_attribute->get_buff_wrapper(index));
+		}
+	}
+}
+
+void AttributeContainer::apply_operated_buff(const Ref<AttributeBuff> &p_buff, LocalVector<int> &r_handles, LocalVector<Ref<RuntimeAttribute>> &r_targets)
+{
+	r_targets.clear();
+
+	if (p_buff->get_static_targets()) {
+		ERR_FAIL_COND_MSG(!p_buff->resolve_static_targets(attribute_set, r_handles), "Could not resolve the static targets of the buff.");
+
+		for (const int handle : r_handles) {
+			RuntimeAttribute *attribute = materialize_attribute(handle);
+
+			ERR_FAIL_NULL_MSG(attribute, "Attribute not found in attribute set.");
+
+			r_targets.push_back(Ref<RuntimeAttribute>(attribute));
+		}
+	} else {
 		TypedArray<AttributeBase> _attributes;
-		TypedArray<RuntimeAttribute> _affected_runtime_attributes;
-		TypedArray<float> buffed_values;
 
 		ERR_FAIL_COND_MSG(!GDVIRTUAL_IS_OVERRIDDEN_PTR(p_buff, _applies_to), "Buff must override the _applies_to method to apply to derived attributes.");
 		ERR_FAIL_COND_MSG(!GDVIRTUAL_CALL_PTR(p_buff, _applies_to, attribute_set, _attributes), "An error occurred calling the overridden _applies_to method.");
 
 		for (int i = 0; i < _attributes.size(); i++) {
-			const Ref<AttributeBase> attribute_base = _attributes[i];
-			Ref<RuntimeAttribute> attribute = get_runtime_attribute_by_name(attribute_base->get_attribute_name());
+			const AttributeBase *attribute_base = cast_to<AttributeBase>(_attributes[i]);
+
+			ERR_FAIL_NULL_MSG(attribute_base, "Attribute not found in attribute set.");
+
+			RuntimeAttribute *attribute = nullptr;
+
+			if (const Ref<RuntimeAttribute> *runtime_attribute = attributes.getptr(attribute_base->get_attribute_name())) {
+				attribute = runtime_attribute->ptr();
+			} else {
+				attribute = materialize_attribute(attribute_set->resolve_handle(attribute_base->get_attribute_name()));
+			}
 
 			ERR_FAIL_NULL_MSG(attribute, "Attribute not found in attribute set.");
 
-			_affected_runtime_attributes.push_back(attribute);
-			buffed_values.push_back(attribute->get_buffed_value());
+			r_targets.push_back(Ref<RuntimeAttribute>(attribute));
 		}
+	}
+
+	if (GDVIRTUAL_IS_OVERRIDDEN_PTR(p_buff, _operate_packed)) {
+		PackedFloat32Array buffed_values;
+		PackedFloat32Array operations;
 
-		TypedArray<AttributeOperation> operations;
+		buffed_values.resize(r_targets.size());
 
-		const bool applied = GDVIRTUAL_CALL_PTR(p_buff, _operate, buffed_values, attribute_set, operations);
+		float *values = buffed_values.ptrw();
 
-		ERR_FAIL_COND_MSG(!applied, "An error occurred calling the overridden _operate method.");
+		for (uint32_t i = 0; i < r_targets.size(); i++) {
+			values[i] = static_cast<float>(r_targets[i]->get_buffed_value());
+		}
+
+		ERR_FAIL_COND_MSG(!GDVIRTUAL_CALL_PTR(p_buff, _operate_packed, buffed_values, attribute_set, operations), "An error occurred calling the overridden _operate_packed method.");
+		ERR_FAIL_COND_MSG(operations.size() % 2 != 0, "The overridden _operate_packed method must return an operand and a value per attribute.");
+		ERR_FAIL_COND_MSG(operations.size() / 2 > static_cast<int64_t>(r_targets.size()), "The overridden _operate_packed method returned more operations than affected attributes.");
 
-		/// we are going to create a new AttributeBuff for each derived attribute affected by the buff
-		/// we will add this buff to each affected runtime attribute.
-		for (int i = 0; i < operations.size(); i++) {
-			Ref<AttributeBuff> derived_buff;
-			derived_buff.instantiate();
+		const float *pairs = operations.ptr();
 
-			const Ref<RuntimeAttribute> &runtime_attribute = _affected_runtime_attributes[i];
+		for (int64_t i = 0; i < operations.size() / 2; i++) {
+			const int operand = static_cast<int>(pairs[i * 2]);
 
-			derived_buff->set_attribute_name(runtime_attribute->get_attribute()->get_attribute_name());
-			derived_buff->set_buff_name(p_buff->get_buff_name());
-			derived_buff->set_duration(p_buff->get_duration());
-			derived_buff->set_duration_merging(p_buff->get_duration_merging());
-			derived_buff->set_parent_buff(p_buff);
-			derived_buff->set_queue_execution(p_buff->get_queue_execution());
-			derived_buff->set_unique(p_buff->get_unique());
-			derived_buff->set_stack_size(p_buff->get_stack_size());
-			derived_buff->set_transient(p_buff->get_transient());
-			derived_buff->set_operation(operations[i]);
+			ERR_CONTINUE_MSG(operand < OP_ADD || operand > OP_SET, "The overridden _operate_packed method returned an invalid operand.");
 
-			 if (Ref<RuntimeBuff> latest_runtime_buff_applied = runtime_attribute->add_buff(derived_buff); latest_runtime_buff_applied.is_valid() && p_buff->get_transient() && !Math::is_zero_approx(p_buff->get_duration())) {
-				emit_signal("buff_enqueued", latest_runtime_buff_applied);
-			} 
+			push_operated_buff(r_targets[i].ptr(), p_buff, operand, static_cast<attribute_real_t>(pairs[i * 2 + 1]));
 		}
-	} else {
-		const Ref<RuntimeAttribute> runtime_attribute = get_runtime_attribute_by_name(p_buff->get_attribute_name());
 
-		ERR_FAIL_COND_MSG(!runtime_attribute.is_valid(), "Attribute '" + p_buff->get_attribute_name() + "' not found in the container.");
-		ERR_FAIL_COND_MSG(runtime_attribute.is_null(), "Attribute reference is not valid.");
+		return;
+	}
+
+	TypedArray<float> buffed_values;
+
+	buffed_values.resize(r_targets.size());
+
+	for (uint32_t i = 0; i < r_targets.size(); i++) {
+		buffed_values[i] = r_targets[i]->get_buffed_value();
+	}
+
+	TypedArray<AttributeOperation> operations;
+
+	const bool applied = GDVIRTUAL_CALL_PTR(p_buff, _operate, buffed_values, attribute_set, operations);
+
+	ERR_FAIL_COND_MSG(!applied, "An error occurred calling the overridden _operate method.");
+	ERR_FAIL_COND_MSG(operations.size() > static_cast<int64_t>(r_targets.size()), "The overridden _operate method returned more operations than affected attributes.");
+
+	/// the buff itself is stored in each affected attribute, the record keeps the operation computed for that attribute.
+	for (int i = 0; i < operations.size(); i++) {
+		const AttributeOperation *operation = cast_to<AttributeOperation>(operations[i]);
+
+		ERR_CONTINUE_MSG(operation == nullptr, "The overridden _operate method returned a null operation.");
+
+		push_operated_buff(r_targets[i].ptr(), p_buff, operation->get_operand(), operation->get_value());
+	}
+}
 
-		if (Ref<RuntimeBuff> latest_runtime_buff_applied = runtime_attribute->add_buff(p_buff); latest_runtime_buff_applied.is_valid() && p_buff->get_transient() && !Math::is_zero_approx(p_buff->get_duration())) {
-			emit_signal("buff_enqueued", latest_runtime_buff_applied);
+Ref<AttributePrototype> AttributeContainer::capture_prototype(const bool p_include_buffs) const
+{
+	Ref<AttributePrototype> prototype;
+	prototype.instantiate();
+
+	prototype->attribute_set = attribute_set;
+	prototype->attribute_set_revision = attribute_set.is_valid() ? attribute_set->revision : 0;
+	prototype->buffs_captured = p_include_buffs;
+	prototype->states.resize(handles.size());
+
+	for (uint32_t handle = 0; handle < handles.size(); handle++) {
+		const RuntimeAttribute *runtime_attribute = handles[handle];
+
+		if (runtime_attribute == nullptr) {
+			continue;
+		}
+
+		AttributePrototype::AttributeState &state = prototype->states[handle];
+
+		state.attribute = runtime_attribute->attribute;
+		state.value = runtime_attribute->load_value();
+		state.previous_value = runtime_attribute->load_previous_value();
+
+		if (p_include_buffs) {
+			for (const RuntimeAttribute::BuffRecord &record : runtime_attribute->buffs) {
+				AttributePrototype::BuffState buff_state;
+				buff_state.buff = record.buff;
+				buff_state.time_left = record.time_left;
+				buff_state.overridden = record.overridden;
+				buff_state.operation = record.operation;
+				state.buffs.push_back(buff_state);
+			}
+		}
+
+		if (const LocalVector<Ref<RuntimeAttribute>> *derived = derived_attributes.getptr(runtime_attribute->attribute->get_attribute_name())) {
+			for (const Ref<RuntimeAttribute> &derived_attribute : *derived) {
+				if (derived_attribute->handle >= 0) {
+					state.derived.push_back(derived_attribute->handle);
+				}
+			}
+		}
+	}
+
+	return prototype;
+}
+
+void AttributeContainer::apply_buff_by_handle(const int p_handle, const Ref<AttributeBuff> &p_buff)
+{
+	ERR_FAIL_NULL_MSG(p_buff, "Buff cannot be null, it must be an instance of a class inheriting from AttributeBuff abstract class.");
+	ERR_FAIL_INDEX_MSG(p_handle, static_cast<int>(handles.size()), "Attribute handle out of bounds.");
+
+	RuntimeAttribute *runtime_attribute = materialize_attribute(p_handle);
+
+	ERR_FAIL_NULL_MSG(runtime_attribute, "Attribute not found in the container.");
+
+	if (int index; runtime_attribute->push_buff(p_buff, index) && index >= 0 && !Math::is_zero_approx(p_buff->get_duration()) && has_connections("buff_enqueued")) {
+		emit_signal("buff_enqueued", runtime_attribute->get_buff_wrapper(index));
+	}
+}
+
+void AttributeContainer::recompute_linear_attributes()
+{
+	TypedArray<AttributeContainer> containers;
+	containers.push_back(this);
+	recompute_linear_attributes_batch(containers);
+}
+
+void AttributeContainer::recompute_linear_attributes_batch(const TypedArray<AttributeContainer> &p_containers)
+{
+	if (p_containers.is_empty()) {
+		return;
+	}
+
+	const AttributeContainer *first = cast_to<AttributeContainer>(p_containers[0]);
+
+	ERR_FAIL_NULL_MSG(first, "Containers cannot be null.");
+
+	const Ref<AttributeSet> batch_attribute_set = first->attribute_set;
+	LocalVector<AttributeContainer *> containers;
+
+	for (int64_t i = 0; i < p_containers.size(); i++) {
+		AttributeContainer *container = cast_to<AttributeContainer>(p_containers[i]);
+
+		ERR_CONTINUE_MSG(container == nullptr, "Containers cannot be null.");
+		ERR_CONTINUE_MSG(container->attribute_set != batch_attribute_set, "All the containers in a batch must share the same AttributeSet.");
+
+		containers.push_back(container);
+	}
+
+	LinearAttributeModel model;
+	model.build(batch_attribute_set);
+
+	if (model.rows.is_empty() || containers.is_empty()) {
+		return;
+	}
+
+	const uint32_t count = containers.size();
+	LocalVector<attribute_real_t> inputs;
+	LocalVector<attribute_real_t> outputs;
+
+	inputs.resize(model.columns.size() * count);
+	outputs.resize(model.rows.size() * count);
+
+	for (uint32_t level = 0; level < model.get_level_count(); level++) {
+		/// gathers the buffed values attribute-major, so each column is contiguous. Columns computed by the previous levels are gathered again, after their commit.
+		for (int64_t column = 0; column < model.columns.size(); column++) {
+			if (level > 0 && !model.is_column_stale(column, level)) {
+				continue;
+			}
+
+			for (uint32_t c = 0; c < count; c++) {
+				const Ref<RuntimeAttribute> runtime_attribute = containers[c]->get_runtime_attribute_by_name(model.columns[column]);
+				inputs[column * count + c] = runtime_attribute.is_valid() ? runtime_attribute->get_buffed_value() : 0.0f;
+			}
+		}
+
+		model.evaluate(inputs.ptr(), outputs.ptr(), count, level);
+
+		/// scatters the results back, emitting the usual change signals.
+		for (uint32_t row = model.level_offsets[level]; row < model.level_offsets[level + 1]; row++) {
+			for (uint32_t c = 0; c < count; c++) {
+				if (const Ref<RuntimeAttribute> runtime_attribute = containers[c]->get_runtime_attribute_by_name(model.rows[row]); runtime_attribute.is_valid()) {
+					runtime_attribute->commit_value(outputs[row * count + c]);
+				}
+			}
 		}
 	}
 }
@@ -234,20 +587,37 @@ void AttributeContainer::remove_attribute(const Ref<AttributeBase> &p_attribute)
 {
 	ERR_FAIL_NULL_MSG(p_attribute, "Attribute cannot be null, it must be an instance of a class inheriting from AttributeBase abstract class.");
 	ERR_FAIL_COND_MSG(!has_attribute(p_attribute), "Attribute not found in the container.");
+	/// a sparse container reports every attribute of its set, materialized or not, so removing one would only reset it to its default.
+	ERR_FAIL_COND_MSG(sparse && attribute_set.is_valid() && attribute_set->resolve_handle(p_attribute->get_attribute_name()) >= 0, "Cannot remove an attribute of the AttributeSet from a sparse container, remove it from the AttributeSet and set the container up again.");
+
+	const Ref<RuntimeAttribute> *runtime_attribute_ptr = attributes.getptr(p_attribute->get_attribute_name());
 
-	const Ref<RuntimeAttribute> runtime_attribute = get_runtime_attribute_by_name(p_attribute->get_name());
+	ERR_FAIL_COND_MSG(runtime_attribute_ptr == nullptr || !runtime_attribute_ptr->is_valid(), "Attribute not valid.");
 
-	ERR_FAIL_COND_MSG(!runtime_attribute.is_valid(), "Attribute not valid.");
+	const Ref<RuntimeAttribute> runtime_attribute = *runtime_attribute_ptr;
 
-	const String attribute_name = runtime_attribute->get_attribute()->get_attribute_name();
+	const StringName attribute_name = runtime_attribute->get_attribute()->get_attribute_name();
 
 	ERR_FAIL_COND_MSG(!attributes.has(attribute_name), "Attribute not found. This is a bug, please open an issue.");
 
-	runtime_attribute->disconnect("attribute_changed", Callable::create(this, "_on_attribute_changed"));
-	runtime_attribute->disconnect("buff_added", Callable::create(this, "_on_buff_applied"));
-	runtime_attribute->disconnect("buff_removed", Callable::create(this, "_on_buff_removed"));
+	record_change(runtime_attribute.ptr());
+	/// the value moves back into the attribute, so references kept by scripts do not read the freed slot.
+	runtime_attribute->unbind_world();
+	runtime_attribute->attribute_container = nullptr;
+
+	if (runtime_attribute->handle >= 0 && static_cast<uint32_t>(runtime_attribute->handle) < handles.size()) {
+		handles[runtime_attribute->handle] = nullptr;
+	}
+
+	for (KeyValue<StringName, LocalVector<Ref<RuntimeAttribute>>> &E : derived_attributes) {
+		E.value.erase(runtime_attribute);
+	}
+
+	ordered_attributes.erase(runtime_attribute.ptr());
 
 	ERR_FAIL_COND_MSG(!attributes.erase(attribute_name), "Failed to remove attribute from container.");
+
+	attributes_version++;
 }
 
 void AttributeContainer::remove_buff(const Ref<AttributeBuff> &p_buff) const
@@ -256,61 +626,260 @@ void AttributeContainer::remove_buff(const Ref<AttributeBuff> &p_buff) const
 	ERR_FAIL_COND_MSG(p_buff.is_null(), "Buff cannot be null, it must be an instance of a class inheriting from AttributeBuff abstract class.");
 
 	if (p_buff->is_operate_overridden()) {
+		/// the targets store the buff itself, so it is removed as is from each of them.
+		if (p_buff->get_static_targets()) {
+			LocalVector<int> targets;
+
+			ERR_FAIL_COND_MSG(!p_buff->resolve_static_targets(attribute_set, targets), "Could not resolve the static targets of the buff.");
+
+			for (const int handle : targets) {
+				if (static_cast<uint32_t>(handle) < handles.size() && handles[handle] != nullptr) {
+					const Ref<RuntimeAttribute> runtime_attribute = handles[handle];
+					runtime_attribute->remove_buff(p_buff);
+				}
+			}
+
+			return;
+		}
+
 		TypedArray<AttributeBase> _attributes;
 
 		ERR_FAIL_COND_MSG(!GDVIRTUAL_IS_OVERRIDDEN_PTR(p_buff, _applies_to), "Buff must override the _applies_to method to apply to derived attributes.");
 		ERR_FAIL_COND_MSG(!GDVIRTUAL_CALL_PTR(p_buff, _applies_to, attribute_set, _attributes), "An error occurred calling the overridden _applies_to method.");
 
 		for (int i = 0; i < _attributes.size(); i++) {
-			Ref<AttributeBuff> buff_copy = p_buff->duplicate();
-			Ref<RuntimeAttribute> runtime_attribute = get_runtime_attribute_by_name(cast_to<Attribute>(_attributes[i])->get_attribute_name());
+			const AttributeBase *attribute_base = cast_to<AttributeBase>(_attributes[i]);
 
-			buff_copy->set_attribute_name(runtime_attribute->attribute->get_attribute_name());
+			if (attribute_base == nullptr) {
+				continue;
+			}
 
-			runtime_attribute->remove_buff(buff_copy);
+			if (const Ref<RuntimeAttribute> *runtime_attribute = attributes.getptr(attribute_base->get_attribute_name())) {
+				(*runtime_attribute)->remove_buff(p_buff);
+			}
 		}
 	} else {
-		Array _attributes = attributes.values();
-
-		for (int i = 0; i < _attributes.size(); i++) {
-			cast_to<RuntimeAttribute>(_attributes[i])->remove_buff(p_buff);
+		/// the listeners may add or remove attributes, so the vector is indexed again after each call and the attribute is held meanwhile.
+		for (uint32_t i = 0; i < ordered_attributes.size(); i++) {
+			const Ref<RuntimeAttribute> runtime_attribute = ordered_attributes[i];
+			runtime_attribute->remove_buff(p_buff);
 		}
 	}
 }
 
 void AttributeContainer::setup()
 {
-	attributes.clear();
+	unbind_world();
+	clear_attributes();
 
 	if (attribute_set.is_valid()) {
-		for (int i = 0; i < attribute_set->count(); i++) {
-			add_attribute(attribute_set->get_at(i));
+		bind_world();
+
+		if (sparse) {
+			handles.resize(attribute_set->count());
+
+			for (uint32_t i = 0; i < handles.size(); i++) {
+				handles[i] = nullptr;
+			}
+
+			/// only the attributes taking part in the dependency graph are materialized upfront, with their parents.
+			for (int i = 0; i < attribute_set->count(); i++) {
+				if (const Ref<AttributeBase> attribute = attribute_set->get_at(i); attribute.is_valid() && attribute->has_dependencies() && !attributes.has(attribute->get_attribute_name())) {
+					add_attribute(attribute);
+				}
+			}
+
+			LocalVector<StringName> parent_names;
+
+			for (const KeyValue<StringName, LocalVector<Ref<RuntimeAttribute>>> &E : derived_attributes) {
+				parent_names.push_back(E.key);
+			}
+
+			for (const StringName &parent_name : parent_names) {
+				materialize_attribute(attribute_set->resolve_handle(parent_name));
+			}
+		} else {
+			for (int i = 0; i < attribute_set->count(); i++) {
+				add_attribute(attribute_set->get_at(i));
+			}
 		}
 	}
 
 	setup_done = true;
 }
 
-Ref<RuntimeAttribute> AttributeContainer::find(const Callable &p_predicate) const
+void AttributeContainer::setup_from_prototype(const Ref<AttributePrototype> &p_prototype)
 {
-	Array _attributes = attributes.values();
+	ERR_FAIL_COND_MSG(p_prototype.is_null(), "Prototype cannot be null.");
+	ERR_FAIL_COND_MSG(p_prototype->attribute_set.is_null(), "Prototype has no AttributeSet.");
+	ERR_FAIL_COND_MSG(p_prototype->attribute_set_revision != p_prototype->attribute_set->revision, "The AttributeSet changed since the prototype was captured, capture the prototype again.");
+
+	unbind_world();
+	clear_attributes();
+
+	attribute_set = p_prototype->attribute_set;
+	bind_world();
+
+	const LocalVector<AttributePrototype::AttributeState> &states = p_prototype->states;
+	handles.resize(states.size());
+
+	/// in sparse mode, the attributes outside of the dependency graph still holding their default state are left to be materialized on demand.
+	LocalVector<bool> in_graph;
+
+	if (sparse) {
+		in_graph.resize(states.size());
 
-	for (int i = 0; i < _attributes.size(); i++) {
-		if (p_predicate.call(_attributes[i])) {
-			return _attributes[i];
+		for (uint32_t handle = 0; handle < states.size(); handle++) {
+			in_graph[handle] = !states[handle].derived.is_empty();
+		}
+
+		for (const AttributePrototype::AttributeState &state : states) {
+			for (const int derived_handle : state.derived) {
+				in_graph[derived_handle] = true;
+			}
+		}
+	}
+
+	/// first pass, the runtime attributes are stamped out with their values and buffs.
+	for (uint32_t handle = 0; handle < states.size(); handle++) {
+		const AttributePrototype::AttributeState &state = states[handle];
+
+		if (state.attribute.is_null()) {
+			handles[handle] = nullptr;
+			continue;
+		}
+
+		if (sparse && !in_graph[handle] && state.buffs.is_empty()) {
+			const attribute_value_t default_value = state.attribute->get_default_value();
+
+			if (is_equal_value(state.value, default_value) && is_equal_value(state.previous_value, default_value)) {
+				handles[handle] = nullptr;
+				continue;
+			}
+		}
+
+		Ref<RuntimeAttribute> runtime_attribute;
+		runtime_attribute.instantiate();
+
+		runtime_attribute->attribute_container = this;
+		runtime_attribute->attribute = state.attribute;
+		runtime_attribute->attribute_set = attribute_set;
+		runtime_attribute->handle = static_cast<int>(handle);
+		runtime_attribute->value = state.value;
+		runtime_attribute->previous_value = state.previous_value;
+
+		runtime_attribute->buffs.resize(state.buffs.size());
+
+		for (uint32_t i = 0; i < state.buffs.size(); i++) {
+			RuntimeAttribute::BuffRecord &record = runtime_attribute->buffs[i];
+
+			record.buff = state.buffs[i].buff;
+			record.time_left = state.buffs[i].time_left;
+			record.overridden = state.buffs[i].overridden;
+			record.operation = state.buffs[i].operation;
+			record.id = runtime_attribute->next_buff_id++;
+		}
+
+		if (world_bound) {
+			runtime_attribute->bind_world(world.ptr(), world_slot);
+		}
+
+		handles[handle] = runtime_attribute.ptr();
+		attributes[state.attribute->get_attribute_name()] = runtime_attribute;
+		ordered_attributes.push_back(runtime_attribute.ptr());
+	}
+
+	/// second pass, the dependency graph is copied as is.
+	for (uint32_t handle = 0; handle < states.size(); handle++) {
+		const AttributePrototype::AttributeState &state = states[handle];
+
+		if (state.attribute.is_null() || state.derived.is_empty()) {
+			continue;
+		}
+
+		LocalVector<Ref<RuntimeAttribute>> &derived = derived_attributes[state.attribute->get_attribute_name()];
+
+		for (const int derived_handle : state.derived) {
+			if (RuntimeAttribute *runtime_attribute = handles[derived_handle]) {
+				derived.push_back(Ref<RuntimeAttribute>(runtime_attribute));
+			}
+		}
+	}
+
+	/// a prototype captured from a sparse container misses the attributes it never materialized, a dense container needs them all.
+	if (!sparse) {
+		for (int handle = 0; handle < attribute_set->count(); handle++) {
+			if (static_cast<uint32_t>(handle) >= handles.size() || handles[handle] == nullptr) {
+				if (const Ref<AttributeBase> attribute = attribute_set->get_at(handle); attribute.is_valid()) {
+					add_attribute(attribute);
+				}
+			}
+		}
+	}
+
+	setup_done = true;
+}
+
+Ref<RuntimeAttribute> AttributeContainer::find(const Callable &p_predicate) const
+{
+	/// the predicate may add or remove attributes, so the vector is indexed again after each call.
+	for (uint32_t i = 0; i < ordered_attributes.size(); i++) {
+		if (const Ref<RuntimeAttribute> runtime_attribute = ordered_attributes[i]; p_predicate.call(runtime_attribute)) {
+			return runtime_attribute;
 		}
 	}
 
 	return nullptr;
 }
 
-float AttributeContainer::find_buffed_value(const Callable &p_predicate) const
+void AttributeContainer::flush_changes()
+{
+	flush_scheduled = false;
+
+	if (pending_changes.is_empty() && pending_buffs.is_empty()) {
+		return;
+	}
+
+	if (!has_connections("attributes_changed")) {
+		clear_pending_changes();
+		return;
+	}
+
+	PackedInt32Array changed_handles;
+	PackedFloat64Array previous_values;
+	PackedFloat64Array values;
+	PackedInt32Array buff_handles;
+	PackedInt32Array buff_ids;
+
+	changed_handles.resize(pending_changes.size());
+	previous_values.resize(pending_changes.size());
+	values.resize(pending_changes.size());
+	buff_handles.resize(pending_buffs.size());
+	buff_ids.resize(pending_buffs.size());
+
+	for (uint32_t i = 0; i < pending_changes.size(); i++) {
+		changed_handles.set(i, pending_changes[i].handle);
+		previous_values.set(i, static_cast<double>(pending_changes[i].previous_value));
+		values.set(i, static_cast<double>(pending_changes[i].value));
+	}
+
+	for (uint32_t i = 0; i < pending_buffs.size(); i++) {
+		buff_handles.set(i, static_cast<int32_t>(pending_buffs[i] >> 32));
+		buff_ids.set(i, static_cast<int32_t>(pending_buffs[i] & 0xFFFFFFFF));
+	}
+
+	/// cleared before emitting, listeners may change the attributes again.
+	clear_pending_changes();
+	emit_signal("attributes_changed", changed_handles, previous_values, values, buff_handles, buff_ids);
+}
+
+attribute_real_t AttributeContainer::find_buffed_value(const Callable &p_predicate) const
 {
 	const Ref<RuntimeAttribute> attribute = find(p_predicate);
 	return attribute.is_valid() ? attribute->get_buffed_value() : 0.0f;
 }
 
-float AttributeContainer::find_value(const Callable &p_predicate) const
+attribute_real_t AttributeContainer::find_value(const Callable &p_predicate) const
 {
 	const Ref<RuntimeAttribute> attribute = find(p_predicate);
 	return attribute.is_valid() ? attribute->get_value() : 0.0f;
@@ -326,36 +895,299 @@ bool AttributeContainer::get_manual_ticking() const
 	return manual_ticking;
 }
 
+int AttributeContainer::get_pool_capacity() const
+{
+	return static_cast<int>(buff_pool.get_capacity());
+}
+
+Dictionary AttributeContainer::get_pool_stats() const
+{
+	Dictionary argument_stats;
+	argument_stats["size"] = argument_pool.get_size();
+	argument_stats["occupancy"] = argument_pool.get_occupancy();
+	argument_stats["hits"] = argument_pool.get_hits();
+	argument_stats["misses"] = argument_pool.get_misses();
+
+	Dictionary buff_stats;
+	buff_stats["size"] = buff_pool.get_size();
+	buff_stats["occupancy"] = buff_pool.get_occupancy();
+	buff_stats["hits"] = buff_pool.get_hits();
+	buff_stats["misses"] = buff_pool.get_misses();
+
+	Dictionary stats;
+	stats["computation_arguments"] = argument_stats;
+	stats["runtime_buffs"] = buff_stats;
+
+	return stats;
+}
+
+PackedInt32Array AttributeContainer::get_changes_since(const int64_t p_version) const
+{
+	PackedInt32Array changed_handles;
+
+	if (p_version >= static_cast<int64_t>(version)) {
+		return changed_handles;
+	}
+
+	/// the journal no longer covers the version, everything may have changed. Sparse handles read their default value even if not materialized.
+	if (p_version < static_cast<int64_t>(journal_floor)) {
+		for (uint32_t handle = 0; handle < handles.size(); handle++) {
+			if (sparse || handles[handle] != nullptr) {
+				changed_handles.push_back(static_cast<int32_t>(handle));
+			}
+		}
+
+		return changed_handles;
+	}
+
+	if (journal_marks.size() < handles.size()) {
+		const uint32_t size = journal_marks.size();
+		journal_marks.resize(handles.size());
+
+		for (uint32_t i = size; i < journal_marks.size(); i++) {
+			journal_marks[i] = 0;
+		}
+	}
+
+	journal_query++;
+
+	/// walked from the newest entry, the entries are sorted by version.
+	for (uint32_t i = journal.size(); i > 0; i--) {
+		const JournalEntry &entry = journal[(journal_head + i - 1) % journal.size()];
+
+		if (static_cast<int64_t>(entry.version) <= p_version) {
+			break;
+		}
+
+		if (static_cast<uint32_t>(entry.handle) < journal_marks.size() && journal_marks[entry.handle] != journal_query) {
+			journal_marks[entry.handle] = journal_query;
+			changed_handles.push_back(entry.handle);
+		}
+	}
+
+	return changed_handles;
+}
+
+int AttributeContainer::get_journal_capacity() const
+{
+	return journal_capacity;
+}
+
+int64_t AttributeContainer::get_version() const
+{
+	return static_cast<int64_t>(version);
+}
+
+Ref<AttributeWorld> AttributeContainer::get_world() const
+{
+	return world;
+}
+
+bool AttributeContainer::is_coalescing_changes() const
+{
+	return coalesce_changes;
+}
+
+bool AttributeContainer::is_sparse() const
+{
+	return sparse;
+}
+
 TypedArray<RuntimeAttribute> AttributeContainer::get_runtime_attributes() const
 {
-	return attributes.values();
+	/// the view is rebuilt only after attributes were added or removed, previously returned views stay untouched.
+	if (attributes_view_version != attributes_version) {
+		TypedArray<RuntimeAttribute> runtime_attributes;
+		runtime_attributes.resize(static_cast<int64_t>(ordered_attributes.size()));
+
+		for (uint32_t i = 0; i < ordered_attributes.size(); i++) {
+			runtime_attributes[i] = ordered_attributes[i];
+		}
+
+		runtime_attributes.make_read_only();
+		attributes_view = runtime_attributes;
+		attributes_view_version = attributes_version;
+	}
+
+	return attributes_view;
 }
 
-Ref<RuntimeAttribute> AttributeContainer::get_runtime_attribute_by_name(const String &p_name) const
+Ref<RuntimeAttribute> AttributeContainer::get_runtime_attribute_by_name(const StringName &p_name)
 {
-	if (attributes.has(p_name)) {
-		return attributes[p_name];
+	if (const Ref<RuntimeAttribute> *attribute = attributes.getptr(p_name)) {
+		return *attribute;
+	}
+
+	if (sparse && attribute_set.is_valid()) {
+		return materialize_attribute(attribute_set->resolve_handle(p_name));
 	}
 
 	return {};
 }
 
-float AttributeContainer::get_attribute_buffed_value_by_name(const String &p_name) const
+Ref<RuntimeAttribute> AttributeContainer::get_runtime_attribute_by_handle(const int p_handle)
 {
-	const Ref<RuntimeAttribute> attribute = get_runtime_attribute_by_name(p_name);
-	return attribute.is_valid() ? attribute->get_buffed_value() : 0.0f;
+	if (p_handle >= 0 && static_cast<uint32_t>(p_handle) < handles.size()) {
+		return materialize_attribute(p_handle);
+	}
+
+	return {};
+}
+
+attribute_real_t AttributeContainer::get_attribute_buffed_value_by_name(const StringName &p_name) const
+{
+	if (const Ref<RuntimeAttribute> *attribute = attributes.getptr(p_name)) {
+		return (*attribute)->get_buffed_value();
+	}
+
+	return sparse && attribute_set.is_valid() ? get_default_value(attribute_set->resolve_handle(p_name)) : 0.0f;
 }
 
-float AttributeContainer::get_attribute_previous_value_by_name(const String &p_name) const
+attribute_real_t AttributeContainer::get_attribute_buffed_value_by_handle(const int p_handle) const
 {
-	const Ref<RuntimeAttribute> attribute = get_runtime_attribute_by_name(p_name);
-	return attribute.is_valid() ? attribute->get_previous_value() : 0.0f;
+	ERR_FAIL_INDEX_V_MSG(p_handle, static_cast<int>(handles.size()), 0.0f, "Attribute handle out of bounds.");
+	return handles[p_handle] ? handles[p_handle]->get_buffed_value() : get_default_value(p_handle);
 }
 
-float AttributeContainer::get_attribute_value_by_name(const String &p_name) const
+attribute_real_t AttributeContainer::get_attribute_previous_value_by_name(const StringName &p_name) const
 {
-	const Ref<RuntimeAttribute> attribute = get_runtime_attribute_by_name(p_name);
-	return attribute.is_valid() ? attribute->get_value() : 0.0f;
+	if (const Ref<RuntimeAttribute> *attribute = attributes.getptr(p_name)) {
+		return (*attribute)->get_previous_value();
+	}
+
+	return sparse && attribute_set.is_valid() ? get_default_value(attribute_set->resolve_handle(p_name)) : 0.0f;
+}
+
+attribute_real_t AttributeContainer::get_attribute_previous_value_by_handle(const int p_handle) const
+{
+	ERR_FAIL_INDEX_V_MSG(p_handle, static_cast<int>(handles.size()), 0.0f, "Attribute handle out of bounds.");
+	return handles[p_handle] ? handles[p_handle]->get_previous_value() : get_default_value(p_handle);
+}
+
+attribute_real_t AttributeContainer::get_attribute_value_by_name(const StringName &p_name) const
+{
+	if (const Ref<RuntimeAttribute> *attribute = attributes.getptr(p_name)) {
+		return (*attribute)->get_value();
+	}
+
+	return sparse && attribute_set.is_valid() ? get_default_value(attribute_set->resolve_handle(p_name)) : 0.0f;
+}
+
+attribute_real_t AttributeContainer::get_attribute_value_by_handle(const int p_handle) const
+{
+	ERR_FAIL_INDEX_V_MSG(p_handle, static_cast<int>(handles.size()), 0.0f, "Attribute handle out of bounds.");
+	return handles[p_handle] ? handles[p_handle]->get_value() : get_default_value(p_handle);
+}
+
+int AttributeContainer::resolve_handle(const StringName &p_name) const
+{
+	ERR_FAIL_COND_V_MSG(attribute_set.is_null(), -1, "The container has no AttributeSet, cannot resolve the handle.");
+	return attribute_set->resolve_handle(p_name);
+}
+
+PackedInt32Array AttributeContainer::resolve_handles(const PackedStringArray &p_names) const
+{
+	ERR_FAIL_COND_V_MSG(attribute_set.is_null(), {}, "The container has no AttributeSet, cannot resolve the handles.");
+
+	PackedInt32Array resolved_handles;
+	resolved_handles.resize(p_names.size());
+
+	for (int64_t i = 0; i < p_names.size(); i++) {
+		resolved_handles.set(i, attribute_set->resolve_handle(p_names[i]));
+	}
+
+	return resolved_handles;
+}
+
+attribute_real_t AttributeContainer::read_value(const int p_handle, const ValueKind p_kind) const
+{
+	ERR_FAIL_INDEX_V_MSG(p_handle, static_cast<int>(handles.size()), 0.0f, "Attribute handle out of bounds.");
+
+	const RuntimeAttribute *runtime_attribute = handles[p_handle];
+
+	if (runtime_attribute == nullptr) {
+		return get_default_value(p_handle);
+	}
+
+	switch (p_kind) {
+		case VALUE_KIND_BUFFED:
+			return runtime_attribute->get_buffed_value();
+		case VALUE_KIND_PREVIOUS:
+			return runtime_attribute->get_previous_value();
+		default:
+			return runtime_attribute->get_value();
+	}
+}
+
+attribute_real_t AttributeContainer::read_value(const StringName &p_name, const ValueKind p_kind) const
+{
+	switch (p_kind) {
+		case VALUE_KIND_BUFFED:
+			return get_attribute_buffed_value_by_name(p_name);
+		case VALUE_KIND_PREVIOUS:
+			return get_attribute_previous_value_by_name(p_name);
+		default:
+			return get_attribute_value_by_name(p_name);
+	}
+}
+
+void AttributeContainer::write_value(RuntimeAttribute *p_attribute, const attribute_real_t p_value)
+{
+	if (p_attribute != nullptr) {
+		p_attribute->commit_value(attribute_value_t(p_value));
+	}
+}
+
+PackedFloat32Array AttributeContainer::get_values_by_handles(const PackedInt32Array &p_handles, const ValueKind p_kind) const
+{
+	PackedFloat32Array values;
+	values.resize(p_handles.size());
+
+	float *write = values.ptrw();
+	const int32_t *read = p_handles.ptr();
+
+	for (int64_t i = 0; i < p_handles.size(); i++) {
+		write[i] = static_cast<float>(read_value(read[i], p_kind));
+	}
+
+	return values;
+}
+
+PackedFloat32Array AttributeContainer::get_values_by_names(const PackedStringArray &p_names, const ValueKind p_kind) const
+{
+	PackedFloat32Array values;
+	values.resize(p_names.size());
+
+	float *write = values.ptrw();
+
+	for (int64_t i = 0; i < p_names.size(); i++) {
+		write[i] = static_cast<float>(read_value(StringName(p_names[i]), p_kind));
+	}
+
+	return values;
+}
+
+PackedFloat32Array AttributeContainer::get_values_batch(const TypedArray<AttributeContainer> &p_containers, const PackedInt32Array &p_handles, const ValueKind p_kind)
+{
+	PackedFloat32Array values;
+	const int64_t handle_count = p_handles.size();
+
+	values.resize(p_containers.size() * handle_count);
+
+	float *write = values.ptrw();
+	const int32_t *read = p_handles.ptr();
+
+	for (int64_t i = 0; i < p_containers.size(); i++) {
+		const AttributeContainer *container = cast_to<AttributeContainer>(p_containers[i]);
+
+		ERR_CONTINUE_MSG(container == nullptr, "Containers cannot be null.");
+
+		for (int64_t j = 0; j < handle_count; j++) {
+			write[i * handle_count + j] = static_cast<float>(container->read_value(read[j], p_kind));
+		}
+	}
+
+	return values;
 }
 
 void AttributeContainer::set_attribute_set(const Ref<AttributeSet> &p_attribute_set)
@@ -364,55 +1196,171 @@ void AttributeContainer::set_attribute_set(const Ref<AttributeSet> &p_attribute_
 	setup();
 }
 
+void AttributeContainer::set_values_by_handles(const PackedInt32Array &p_handles, const PackedFloat32Array &p_values)
+{
+	ERR_FAIL_COND_MSG(p_handles.size() != p_values.size(), "The handles and the values must have the same size.");
+
+	const int32_t *read_handles = p_handles.ptr();
+	const float *read_values = p_values.ptr();
+
+	for (int64_t i = 0; i < p_handles.size(); i++) {
+		ERR_CONTINUE_MSG(read_handles[i] < 0 || read_handles[i] >= static_cast<int>(handles.size()), "Attribute handle out of bounds.");
+		write_value(materialize_attribute(read_handles[i]), read_values[i]);
+	}
+}
+
+void AttributeContainer::set_values_by_names(const PackedStringArray &p_names, const PackedFloat32Array &p_values)
+{
+	ERR_FAIL_COND_MSG(p_names.size() != p_values.size(), "The names and the values must have the same size.");
+
+	const float *read_values = p_values.ptr();
+
+	for (int64_t i = 0; i < p_names.size(); i++) {
+		const Ref<RuntimeAttribute> runtime_attribute = get_runtime_attribute_by_name(p_names[i]);
+
+		ERR_CONTINUE_MSG(runtime_attribute.is_null(), "Attribute '" + p_names[i] + "' not found in the container.");
+		write_value(runtime_attribute.ptr(), read_values[i]);
+	}
+}
+
+void AttributeContainer::set_coalesce_changes(const bool p_value)
+{
+	if (coalesce_changes == p_value) {
+		return;
+	}
+
+	coalesce_changes = p_value;
+
+	if (!coalesce_changes) {
+		flush_changes();
+	}
+}
+
+void AttributeContainer::set_journal_capacity(const int p_value)
+{
+	ERR_FAIL_COND_MSG(p_value < 0, "The journal capacity cannot be negative.");
+
+	journal_capacity = p_value;
+	reset_journal();
+}
+
 void AttributeContainer::set_manual_ticking(bool p_manual_ticking)
 {
 	manual_ticking = p_manual_ticking;
 }
 
-void AttributeContainer::subtract_attribute_buffs_ticks(float p_tick)
+void AttributeContainer::set_pool_capacity(const int p_value)
 {
-	const TypedArray<RuntimeAttribute> &runtime_attributes = attributes.values();
+	ERR_FAIL_COND_MSG(p_value < 0, "Pool capacity cannot be negative.");
 
-	for (int64_t i = 0; i < runtime_attributes.size(); i++) {
-		const Ref<RuntimeAttribute> &attribute = runtime_attributes[i];
+	argument_pool.set_capacity(p_value);
+	buff_pool.set_capacity(p_value);
+}
 
-		if (!attribute.is_valid()) {
-			continue;
-		}
+void AttributeContainer::set_sparse(const bool p_value)
+{
+	sparse = p_value;
 
-		TypedArray<RuntimeBuff> buffs = attribute->get_buffs();
-
-		for (int64_t j = buffs.size() - 1; j >= 0; j--) {
-			if (const Ref<RuntimeBuff> &buff = buffs[j]; buff.is_valid() && buff->is_transient_time_based()) {
-				/// check if the buff needs a waterfall or parallel execution.
-				/// for the latter, keep the code as it is
-				/// for the first, check if another buff of the same
-				/// type exists in the queue and,
-				/// if present, avoid setting the time left.
-				if (buff->get_buff()->get_queue_execution() == AttributeBuff::QueueExecution::QUEUE_EXECUTION_WATERFALL) {
-					bool should_skip = false;
-
-					/// we act as a fifo, so let's see if there are other buffs applied before the current one.
-					for (int64_t k = j - 1; k >= 0; k--) {
-						if (const Ref<RuntimeBuff> other_buff = buffs[k]; other_buff->equals_to(buff->buff)) {
-							should_skip = true;
-							break;
-						}
-					}
+	if (setup_done) {
+		setup();
+	}
+}
 
-					if (should_skip) {
-						continue;
+void AttributeContainer::set_world(const Ref<AttributeWorld> &p_world)
+{
+	if (world == p_world) {
+		return;
+	}
+
+	unbind_world();
+	world = p_world;
+
+	if (setup_done) {
+		setup();
+	}
+}
+
+void AttributeContainer::subtract_attribute_buffs_ticks(const float p_tick)
+{
+	/// the listeners are looked up once per tick. Connections change only when script code runs, so the flags are refreshed after each emission or removal.
+	bool time_elapsed_listened = has_connections("buff_time_elapsed");
+	bool dequeued_listened = has_connections("buff_dequeued");
+
+	/// the listeners may add or remove attributes, so the vector is indexed again after each attribute and the attribute is held meanwhile.
+	for (uint32_t i = 0; i < ordered_attributes.size(); i++) {
+		const Ref<RuntimeAttribute> attribute = ordered_attributes[i];
+
+		/// the records are walked in place, wrappers are created only for the signals someone listens to.
+		for (int64_t j = static_cast<int64_t>(attribute->buffs.size()) - 1; j >= 0; j--) {
+			if (j >= static_cast<int64_t>(attribute->buffs.size())) {
+				continue;
+			}
+
+			RuntimeAttribute::BuffRecord &record = attribute->buffs[j];
+			const AttributeBuff *buff = record.buff.ptr();
+
+			if (buff == nullptr || !buff->get_transient() || Math::is_zero_approx(buff->get_duration())) {
+				continue;
+			}
+
+			/// check if the buff needs a waterfall or parallel execution.
+			/// for the latter, keep the code as it is
+			/// for the first, check if another buff of the same
+			/// type exists in the queue and,
+			/// if present, avoid setting the time left.
+			if (buff->get_queue_execution() == AttributeBuff::QueueExecution::QUEUE_EXECUTION_WATERFALL) {
+				bool should_skip = false;
+
+				/// we act as a fifo, so let's see if there are other buffs applied before the current one.
+				for (int64_t k = j - 1; k >= 0; k--) {
+					if (attribute->buffs[k].buff->equals_to(record.buff)) {
+						should_skip = true;
+						break;
 					}
 				}
 
-				buff->set_time_left(buff->get_time_left() - p_tick);
+				if (should_skip) {
+					continue;
+				}
+			}
+
+			record.time_left = Math::clamp(record.time_left - p_tick, 0.0f, buff->get_duration());
+
+			/// the listeners may add or remove buffs, so the record is looked up again by id after each emission.
+			const uint32_t id = record.id;
 
-				emit_signal("buff_time_elapsed", buff);
+			if (coalesce_changes && attribute->handle >= 0) {
+				queue_buff_change(attribute.ptr(), j);
+			} else if (time_elapsed_listened) {
+				emit_signal("buff_time_elapsed", attribute->get_buff_wrapper(j));
+				time_elapsed_listened = has_connections("buff_time_elapsed");
+				dequeued_listened = has_connections("buff_dequeued");
 
-				if (buff->can_dequeue()) {
-					emit_signal("buff_dequeued", buff);
-					remove_buff(buff->buff);
+				const int index = attribute->find_buff_index(id);
+
+				if (index < 0) {
+					continue;
 				}
+
+				j = index;
+			}
+
+			if (Math::is_zero_approx(attribute->buffs[j].time_left)) {
+				if (dequeued_listened) {
+					emit_signal("buff_dequeued", attribute->get_buff_wrapper(j));
+
+					const int index = attribute->find_buff_index(id);
+
+					if (index < 0) {
+						continue;
+					}
+
+					j = index;
+				}
+
+				attribute->remove_buff_at(j);
+				time_elapsed_listened = has_connections("buff_time_elapsed");
+				dequeued_listened = has_connections("buff_dequeued");
 			}
 		}
 	}
@@ -421,34 +1369,74 @@ void AttributeContainer::subtract_attribute_buffs_ticks(float p_tick)
 void AttributeContainer::_bind_methods()
 {
 	/// binds methods to godot
-	ClassDB::bind_method(D_METHOD("_on_attribute_changed", "p_attribute", "p_previous_value", "p_new_value"), &AttributeContainer::_on_attribute_changed);
-	ClassDB::bind_method(D_METHOD("_on_buff_applied", "p_buff"), &AttributeContainer::_on_buff_applied);
-	ClassDB::bind_method(D_METHOD("_on_buff_removed", "p_buff"), &AttributeContainer::_on_buff_removed);
-	ClassDB::bind_method(D_METHOD("_on_buff_time_updated", "p_buff"), &AttributeContainer::_on_buff_time_updated);
 	ClassDB::bind_method(D_METHOD("add_attribute", "p_attribute"), &AttributeContainer::add_attribute);
 	ClassDB::bind_method(D_METHOD("apply_buff", "p_buff"), &AttributeContainer::apply_buff);
+	ClassDB::bind_method(D_METHOD("apply_buff_by_handle", "p_handle", "p_buff"), &AttributeContainer::apply_buff_by_handle);
+	ClassDB::bind_method(D_METHOD("capture_prototype", "p_include_buffs"), &AttributeContainer::capture_prototype, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("find", "p_predicate"), &AttributeContainer::find);
 	ClassDB::bind_method(D_METHOD("find_buffed_value", "p_predicate"), &AttributeContainer::find_buffed_value);
 	ClassDB::bind_method(D_METHOD("find_value", "p_predicate"), &AttributeContainer::find_value);
+	ClassDB::bind_method(D_METHOD("flush_changes"), &AttributeContainer::flush_changes);
 	ClassDB::bind_method(D_METHOD("get_attribute_set"), &AttributeContainer::get_attribute_set);
 	ClassDB::bind_method(D_METHOD("get_attributes"), &AttributeContainer::get_runtime_attributes);
+	ClassDB::bind_method(D_METHOD("get_attribute_by_handle", "p_handle"), &AttributeContainer::get_runtime_attribute_by_handle);
 	ClassDB::bind_method(D_METHOD("get_attribute_by_name", "p_name"), &AttributeContainer::get_runtime_attribute_by_name);
+	ClassDB::bind_method(D_METHOD("get_attribute_buffed_value_by_handle", "p_handle"), &AttributeContainer::get_attribute_buffed_value_by_handle);
 	ClassDB::bind_method(D_METHOD("get_attribute_buffed_value_by_name", "p_name"), &AttributeContainer::get_attribute_buffed_value_by_name);
+	ClassDB::bind_method(D_METHOD("get_attribute_previous_value_by_handle", "p_handle"), &AttributeContainer::get_attribute_previous_value_by_handle);
+	ClassDB::bind_method(D_METHOD("get_attribute_value_by_handle", "p_handle"), &AttributeContainer::get_attribute_value_by_handle);
 	ClassDB::bind_method(D_METHOD("get_attribute_value_by_name", "p_name"), &AttributeContainer::get_attribute_value_by_name);
+	ClassDB::bind_method(D_METHOD("get_changes_since", "p_version"), &AttributeContainer::get_changes_since);
+	ClassDB::bind_method(D_METHOD("get_journal_capacity"), &AttributeContainer::get_journal_capacity);
 	ClassDB::bind_method(D_METHOD("get_manual_ticking"), &AttributeContainer::get_manual_ticking);
+	ClassDB::bind_method(D_METHOD("get_pool_capacity"), &AttributeContainer::get_pool_capacity);
+	ClassDB::bind_method(D_METHOD("get_pool_stats"), &AttributeContainer::get_pool_stats);
+	ClassDB::bind_method(D_METHOD("get_values_by_handles", "p_handles", "p_kind"), &AttributeContainer::get_values_by_handles, DEFVAL(VALUE_KIND_VALUE));
+	ClassDB::bind_method(D_METHOD("get_values_by_names", "p_names", "p_kind"), &AttributeContainer::get_values_by_names, DEFVAL(VALUE_KIND_VALUE));
+	ClassDB::bind_method(D_METHOD("get_version"), &AttributeContainer::get_version);
+	ClassDB::bind_method(D_METHOD("get_world"), &AttributeContainer::get_world);
+	ClassDB::bind_method(D_METHOD("is_coalescing_changes"), &AttributeContainer::is_coalescing_changes);
+	ClassDB::bind_method(D_METHOD("is_sparse"), &AttributeContainer::is_sparse);
+	ClassDB::bind_method(D_METHOD("recompute_linear_attributes"), &AttributeContainer::recompute_linear_attributes);
 	ClassDB::bind_method(D_METHOD("remove_attribute", "p_attribute"), &AttributeContainer::remove_attribute);
 	ClassDB::bind_method(D_METHOD("remove_buff", "p_buff"), &AttributeContainer::remove_buff);
+	ClassDB::bind_method(D_METHOD("resolve_handle", "p_name"), &AttributeContainer::resolve_handle);
+	ClassDB::bind_method(D_METHOD("resolve_handles", "p_names"), &AttributeContainer::resolve_handles);
 	ClassDB::bind_method(D_METHOD("set_attribute_set", "p_attribute_set"), &AttributeContainer::set_attribute_set);
 	ClassDB::bind_method(D_METHOD("setup"), &AttributeContainer::setup);
+	ClassDB::bind_method(D_METHOD("setup_from_prototype", "p_prototype"), &AttributeContainer::setup_from_prototype);
+	ClassDB::bind_method(D_METHOD("set_coalesce_changes", "p_value"), &AttributeContainer::set_coalesce_changes);
+	ClassDB::bind_method(D_METHOD("set_journal_capacity", "p_value"), &AttributeContainer::set_journal_capacity);
 	ClassDB::bind_method(D_METHOD("set_manual_ticking", "p_manual_ticking"), &AttributeContainer::set_manual_ticking);
+	ClassDB::bind_method(D_METHOD("set_pool_capacity", "p_value"), &AttributeContainer::set_pool_capacity);
+	ClassDB::bind_method(D_METHOD("set_sparse", "p_value"), &AttributeContainer::set_sparse);
+	ClassDB::bind_method(D_METHOD("set_values_by_handles", "p_handles", "p_values"), &AttributeContainer::set_values_by_handles);
+	ClassDB::bind_method(D_METHOD("set_values_by_names", "p_names", "p_values"), &AttributeContainer::set_values_by_names);
+	ClassDB::bind_method(D_METHOD("set_world", "p_world"), &AttributeContainer::set_world);
 	ClassDB::bind_method(D_METHOD("subtract_attribute_buffs_ticks", "p_tick"), &AttributeContainer::subtract_attribute_buffs_ticks);
 
+	/// binds static methods to godot
+	ClassDB::bind_static_method("AttributeContainer", D_METHOD("get_native_api", "p_version"), &AttributeContainer::get_native_api);
+	ClassDB::bind_static_method("AttributeContainer", D_METHOD("get_values_batch", "p_containers", "p_handles", "p_kind"), &AttributeContainer::get_values_batch, DEFVAL(VALUE_KIND_VALUE));
+	ClassDB::bind_static_method("AttributeContainer", D_METHOD("recompute_linear_attributes_batch", "p_containers"), &AttributeContainer::recompute_linear_attributes_batch);
+
+	/// binds enum constants
+	BIND_ENUM_CONSTANT(VALUE_KIND_VALUE);
+	BIND_ENUM_CONSTANT(VALUE_KIND_BUFFED);
+	BIND_ENUM_CONSTANT(VALUE_KIND_PREVIOUS);
+
 	/// binds properties to godot
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "attribute_set", PROPERTY_HINT_RESOURCE_TYPE, "AttributeSet"), "set_attribute_set", "get_attribute_set");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "coalesce_changes"), "set_coalesce_changes", "is_coalescing_changes");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "journal_capacity", PROPERTY_HINT_RANGE, "0,4096,1,or_greater"), "set_journal_capacity", "get_journal_capacity");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "manual_ticking"), "set_manual_ticking", "get_manual_ticking");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "pool_capacity", PROPERTY_HINT_RANGE, "0,1024,1,or_greater"), "set_pool_capacity", "get_pool_capacity");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "sparse"), "set_sparse", "is_sparse");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "world", PROPERTY_HINT_RESOURCE_TYPE, "AttributeWorld"), "set_world", "get_world");
 
 	/// signals binding
 	ADD_SIGNAL(MethodInfo("attribute_changed", PropertyInfo(Variant::OBJECT, "attribute", PROPERTY_HINT_RESOURCE_TYPE, "RuntimeAttributeBase"), PropertyInfo(Variant::FLOAT, "previous_value"), PropertyInfo(Variant::FLOAT, "new_value")));
+	ADD_SIGNAL(MethodInfo("attributes_changed", PropertyInfo(Variant::PACKED_INT32_ARRAY, "handles"), PropertyInfo(Variant::PACKED_FLOAT64_ARRAY, "previous_values"), PropertyInfo(Variant::PACKED_FLOAT64_ARRAY, "values"), PropertyInfo(Variant::PACKED_INT32_ARRAY, "buff_handles"), PropertyInfo(Variant::PACKED_INT32_ARRAY, "buff_ids")));
 	ADD_SIGNAL(MethodInfo("buff_applied", PropertyInfo(Variant::OBJECT, "buff", PROPERTY_HINT_RESOURCE_TYPE, "RuntimeBuff")));
 	ADD_SIGNAL(MethodInfo("buff_dequeued", PropertyInfo(Variant::OBJECT, "buff", PROPERTY_HINT_RESOURCE_TYPE, "RuntimeBuff")));
 	ADD_SIGNAL(MethodInfo("buff_enqueued", PropertyInfo(Variant::OBJECT, "buff", PROPERTY_HINT_RESOURCE_TYPE, "RuntimeBuff")));
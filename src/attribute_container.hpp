@@ -12,6 +12,12 @@
 #define OCTOD_GAMEPLAY_ATTRIBUTES_ATTRIBUTE_CONTAINER_H
 
 #include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+#include "attribute_value.hpp"
+#include "object_pool.hpp"
 
 using namespace godot;
 
@@ -19,7 +25,11 @@ namespace octod::gameplay::attributes
 {
 	class AttributeBase;
 	class AttributeBuff;
+	class AttributeComputationArgument;
+	class AttributeNativeApi;
+	class AttributePrototype;
 	class AttributeSet;
+	class AttributeWorld;
 	class RuntimeAttribute;
 	class RuntimeBuff;
 
@@ -28,7 +38,22 @@ namespace octod::gameplay::attributes
 	{
 		GDCLASS(AttributeContainer, Node);
 
+		friend class AttributeNativeApi;
+		friend class AttributeWorld;
+		friend class RuntimeAttribute;
+
 	public:
+		/// @brief The values read by the packed getters.
+		enum ValueKind : uint8_t
+		{
+			/// the base value, without the transient buffs
+			VALUE_KIND_VALUE,
+			/// the value with the transient buffs applied
+			VALUE_KIND_BUFFED,
+			/// the value before the last change
+			VALUE_KIND_PREVIOUS,
+		};
+
 		/// @brief Adds an attribute to the container.
 		/// @param p_attribute The attribute to add.
 		void add_attribute(const Ref<AttributeBase> &p_attribute);
@@ -37,7 +62,29 @@ namespace octod::gameplay::attributes
 		/// @param p_buff The buff to add.
 		void apply_buff(const Ref<AttributeBuff> &p_buff);
 
-		/// @brief Removes an attribute from the container.
+		/// @brief Adds a buff to an attribute by its handle, skipping the name lookup. The buff `_operate` and `_applies_to` overrides are not used.
+		/// @param p_handle The attribute handle, see `resolve_handle`.
+		/// @param p_buff The buff to add.
+		void apply_buff_by_handle(int p_handle, const Ref<AttributeBuff> &p_buff);
+
+		/// @brief Captures the runtime state of the container, to set up other containers with `setup_from_prototype`.
+		/// @param p_include_buffs If true, the buffs applied to the container are captured too.
+		/// @return The prototype.
+		[[nodiscard]] Ref<AttributePrototype> capture_prototype(bool p_include_buffs = false) const;
+
+		/// @brief Gets the native API table, for other GDExtensions. See `attribute_native_api.hpp`.
+		/// @param p_version The version of the API the caller was compiled against.
+		/// @return The address of the GameplayAttributesNativeApi table, 0 if the version is not supported.
+		static int64_t get_native_api(int p_version);
+
+		/// @brief Recomputes every LinearAttribute of the container in a single sparse matrix-vector pass.
+		void recompute_linear_attributes();
+
+		/// @brief Recomputes every LinearAttribute of many containers sharing the same AttributeSet in one batched sparse matrix-vector pass.
+		/// @param p_containers The containers to recompute.
+		static void recompute_linear_attributes_batch(const TypedArray<AttributeContainer> &p_containers);
+
+		/// @brief Removes an attribute from the container. Fails in sparse mode for the attributes of the set, which are always reported.
 		/// @param p_attribute The attribute to remove.
 		void remove_attribute(const Ref<AttributeBase> &p_attribute);
 
@@ -45,23 +92,40 @@ namespace octod::gameplay::attributes
 		/// @param p_buff The buff to remove.
 		void remove_buff(const Ref<AttributeBuff> &p_buff) const;
 
+		/// @brief Resolves an attribute name into its handle in the container attribute set.
+		/// @param p_name The attribute name.
+		/// @return The attribute handle, -1 if the attribute is not in the set.
+		[[nodiscard]] int resolve_handle(const StringName &p_name) const;
+
+		/// @brief Resolves many attribute names into their handles, to use the packed `_by_handles` methods.
+		/// @param p_names The attribute names.
+		/// @return The attribute handles, -1 for the attributes not in the set.
+		[[nodiscard]] PackedInt32Array resolve_handles(const PackedStringArray &p_names) const;
+
 		/// @brief Sets up the container.
 		void setup();
 
+		/// @brief Sets up the container copying the runtime state of a prototype, skipping the dependency discovery of `setup`. No change signal is emitted.
+		/// @param p_prototype The prototype, see `capture_prototype`.
+		void setup_from_prototype(const Ref<AttributePrototype> &p_prototype);
+
 		/// @brief Finds an attribute in the container.
 		/// @param p_predicate The predicate to use to find the attribute.
 		/// @return The attribute found.
 		[[nodiscard]] Ref<RuntimeAttribute> find(const Callable &p_predicate) const;
 
+		/// @brief Emits the `attributes_changed` signal with the changes collected since the last flush. Called at the end of the frame while coalescing.
+		void flush_changes();
+
 		/// @brief Finds an attribute buffed value in the container.
 		/// @param p_predicate The predicate to use to find the attribute buffed value.
 		/// @return The attribute buffed value found.
-		[[nodiscard]] float find_buffed_value(const Callable &p_predicate) const;
+		[[nodiscard]] attribute_real_t find_buffed_value(const Callable &p_predicate) const;
 
 		/// @brief Finds an attribute value in the container.
 		/// @param p_predicate The predicate to use to find the attribute value.
 		/// @return The attribute value found.
-		[[nodiscard]] float find_value(const Callable &p_predicate) const;
+		[[nodiscard]] attribute_real_t find_value(const Callable &p_predicate) const;
 
 		// getters/setters
 		/// @brief Returns the attributes of the container.
@@ -72,38 +136,140 @@ namespace octod::gameplay::attributes
 		/// @return The flag.
 		[[nodiscard]] bool get_manual_ticking() const;
 
-		/// @brief Returns the attributes of the container.
+		/// @brief Gets the maximum number of objects kept by each of the container pools.
+		/// @return The pool capacity.
+		[[nodiscard]] int get_pool_capacity() const;
+
+		/// @brief Gets the occupancy and hit/miss counters of the RuntimeBuff and AttributeComputationArgument pools.
+		/// @return The pool stats, keyed by pool name.
+		[[nodiscard]] Dictionary get_pool_stats() const;
+
+		/// @brief Gets the handles of the attributes changed after a version, each listed once. If the journal no longer covers the version, every attribute handle is returned.
+		/// @param p_version A version returned by `get_version`.
+		/// @return The changed attribute handles.
+		[[nodiscard]] PackedInt32Array get_changes_since(int64_t p_version) const;
+
+		/// @brief Gets the maximum number of changes kept by the journal.
+		/// @return The journal capacity.
+		[[nodiscard]] int get_journal_capacity() const;
+
+		/// @brief Gets the version of the container, bumped each time an attribute value or buffs change, or when attributes are added or removed.
+		/// @return The version.
+		[[nodiscard]] int64_t get_version() const;
+
+		/// @brief Returns if the container coalesces the change notifications, see `set_coalesce_changes`.
+		/// @return True if the changes are coalesced, false otherwise.
+		[[nodiscard]] bool is_coalescing_changes() const;
+
+		/// @brief Returns the world storing the attribute values.
+		/// @return The world, null if the values are stored in the runtime attributes.
+		[[nodiscard]] Ref<AttributeWorld> get_world() const;
+
+		/// @brief Returns if the container materializes its attributes lazily.
+		/// @return True if the container is sparse, false otherwise.
+		[[nodiscard]] bool is_sparse() const;
+
+		/// @brief Returns the attributes of the container, in insertion order. The array is read-only and shared until attributes are added or removed.
 		/// @return The attributes of the container.
 		[[nodiscard]] TypedArray<RuntimeAttribute> get_runtime_attributes() const;
 
-		/// @brief Gets an attribute by name.
+		/// @brief Gets an attribute by name. In sparse mode, the attribute is materialized if needed.
 		/// @param p_name The name of the attribute to get.
 		/// @return The attribute with the given name.
-		[[nodiscard]] Ref<RuntimeAttribute> get_runtime_attribute_by_name(const String &p_name) const;
+		[[nodiscard]] Ref<RuntimeAttribute> get_runtime_attribute_by_name(const StringName &p_name);
+
+		/// @brief Gets an attribute by handle. In sparse mode, the attribute is materialized if needed.
+		/// @param p_handle The handle of the attribute to get, see `resolve_handle`.
+		/// @return The attribute with the given handle.
+		[[nodiscard]] Ref<RuntimeAttribute> get_runtime_attribute_by_handle(int p_handle);
 
 		/// @brief Gets the buffed value of an attribute by name. It returns 0.0f if the attribute is not found. Or if the actual value is 0.0f.
 		/// @param p_name The name of the attribute to get.
 		/// @return The buffed value of the attribute with the given name.
-		[[nodiscard]] float get_attribute_buffed_value_by_name(const String &p_name) const;
+		[[nodiscard]] attribute_real_t get_attribute_buffed_value_by_name(const StringName &p_name) const;
+
+		/// @brief Gets the buffed value of an attribute by handle. It returns 0.0f if the attribute is not found.
+		/// @param p_handle The handle of the attribute to get.
+		/// @return The buffed value of the attribute with the given handle.
+		[[nodiscard]] attribute_real_t get_attribute_buffed_value_by_handle(int p_handle) const;
 
 		/// @brief Gets the value of an attribute by name.
 		/// @param p_name The name of the attribute to get.
 		/// @return The value of the attribute with the given name.
-		[[nodiscard]] float get_attribute_previous_value_by_name(const String &p_name) const;
+		[[nodiscard]] attribute_real_t get_attribute_previous_value_by_name(const StringName &p_name) const;
+
+		/// @brief Gets the previous value of an attribute by handle.
+		/// @param p_handle The handle of the attribute to get.
+		/// @return The previous value of the attribute with the given handle.
+		[[nodiscard]] attribute_real_t get_attribute_previous_value_by_handle(int p_handle) const;
 
 		/// @brief Gets the base value of an attribute by name.
 		/// @param p_name The name of the attribute to get.
 		/// @return The base value of the attribute with the given name.
-		[[nodiscard]] float get_attribute_value_by_name(const String &p_name) const;
+		[[nodiscard]] attribute_real_t get_attribute_value_by_name(const StringName &p_name) const;
+
+		/// @brief Gets the base value of an attribute by handle.
+		/// @param p_handle The handle of the attribute to get.
+		/// @return The base value of the attribute with the given handle.
+		[[nodiscard]] attribute_real_t get_attribute_value_by_handle(int p_handle) const;
+
+		/// @brief Gets the values of many attributes by handle in a single call.
+		/// @param p_handles The attribute handles, see `resolve_handles`.
+		/// @param p_kind The value to read.
+		/// @return The values, in the order of the handles.
+		[[nodiscard]] PackedFloat32Array get_values_by_handles(const PackedInt32Array &p_handles, ValueKind p_kind = VALUE_KIND_VALUE) const;
+
+		/// @brief Gets the values of many attributes by name in a single call.
+		/// @param p_names The attribute names.
+		/// @param p_kind The value to read.
+		/// @return The values, in the order of the names.
+		[[nodiscard]] PackedFloat32Array get_values_by_names(const PackedStringArray &p_names, ValueKind p_kind = VALUE_KIND_VALUE) const;
+
+		/// @brief Gets the values of the same attributes of many containers in a single call.
+		/// @param p_containers The containers, sharing the same AttributeSet.
+		/// @param p_handles The attribute handles.
+		/// @param p_kind The value to read.
+		/// @return The values, container-major: the values of the first container come first, in the order of the handles.
+		static PackedFloat32Array get_values_batch(const TypedArray<AttributeContainer> &p_containers, const PackedInt32Array &p_handles, ValueKind p_kind = VALUE_KIND_VALUE);
 
 		/// @brief Sets the attributes of the container.
 		/// @param p_attribute_set The attributes to set.
 		void set_attribute_set(const Ref<AttributeSet> &p_attribute_set);
 
+		/// @brief Sets the values of many attributes by handle in a single call. The values are clamped and notified as any other change.
+		/// @param p_handles The attribute handles, see `resolve_handles`.
+		/// @param p_values The values, in the order of the handles.
+		void set_values_by_handles(const PackedInt32Array &p_handles, const PackedFloat32Array &p_values);
+
+		/// @brief Sets the values of many attributes by name in a single call. The values are clamped and notified as any other change.
+		/// @param p_names The attribute names.
+		/// @param p_values The values, in the order of the names.
+		void set_values_by_names(const PackedStringArray &p_names, const PackedFloat32Array &p_values);
+
 		/// @brief Sets the manual_ticking bool
 		/// @param p_manual_ticking True to handle manual ticking programmatically. See `AttributeContainer::set_tick(float p_tick)` function
 		void set_manual_ticking(bool p_manual_ticking);
 
+		/// @brief Sets if the container coalesces the change notifications. While coalescing, `attribute_changed` and `buff_time_elapsed` are not emitted, the changes are collected and emitted once per frame by `attributes_changed`. Disabling it flushes the pending changes.
+		/// @param p_value True to coalesce the changes.
+		void set_coalesce_changes(bool p_value);
+
+		/// @brief Sets the maximum number of changes kept by the journal. The journal is cleared, 0 disables it.
+		/// @param p_value The journal capacity.
+		void set_journal_capacity(int p_value);
+
+		/// @brief Sets the maximum number of objects kept by each of the container pools.
+		/// @param p_value The pool capacity.
+		void set_pool_capacity(int p_value);
+
+		/// @brief Sets if the container materializes its attributes lazily. The container is set up again.
+		/// @param p_value True to make the container sparse.
+		void set_sparse(bool p_value);
+
+		/// @brief Sets the world storing the attribute values. The container is set up again.
+		/// @param p_world The world, null to store the values in the runtime attributes.
+		void set_world(const Ref<AttributeWorld> &p_world);
+
 		/// @brief Subtracts the passed p_tick value to all timed transient AttributeBuff instances durations in the container.
 		/// 	   Ideal for turn-based games or to handle programmatic resets/updates.
 		/// @param p_tick The tick value. The value passed is subtracted from transient AttributeBuff durations
@@ -114,37 +280,190 @@ namespace octod::gameplay::attributes
 		static void _bind_methods();
 		/// @brief Attribute's set.
 		Ref<AttributeSet> attribute_set;
-		/// @brief TypedArray of attributes.
-		Dictionary attributes;
-		/// @brief Derived attributes. These are attributes that are calculated from other attributes.
-		Dictionary derived_attributes;
+		/// @brief The runtime attributes, keyed by attribute name.
+		HashMap<StringName, Ref<RuntimeAttribute>> attributes;
+		/// @brief The runtime attributes, in insertion order. Owned by `attributes`, iterated by the internal loops.
+		LocalVector<RuntimeAttribute *> ordered_attributes;
+		/// @brief The read-only array returned to scripts by `get_runtime_attributes`.
+		mutable TypedArray<RuntimeAttribute> attributes_view;
+		/// @brief The `attributes_version` the view was built at.
+		mutable uint32_t attributes_view_version = 0;
+		/// @brief The runtime attributes, indexed by their attribute set handle. Missing attributes are stored as nullptr.
+		LocalVector<RuntimeAttribute *> handles;
+		/// @brief Derived attributes, keyed by the name of the attribute they derive from.
+		HashMap<StringName, LocalVector<Ref<RuntimeAttribute>>> derived_attributes;
+		/// @brief Bumped each time an attribute is added or removed. Used to invalidate cached parent pointers.
+		uint32_t attributes_version = 1;
 		/// @brief If set to true, AttributeBuff durations are going to be handled by you.
 		bool manual_ticking = false;
+		/// @brief If set to true, the value and time elapsed notifications are collected and emitted once per frame.
+		bool coalesce_changes = false;
+		/// @brief If a `flush_changes` call is already deferred.
+		bool flush_scheduled = false;
+		/// @brief If set to true, attributes without dependencies are materialized on their first write or buff, and read their default value until then.
+		bool sparse = false;
 		/// @brief If set to true, the automatic attributes setup occurred
 		bool setup_done = false;
+		/// @brief The world storing the attribute values, shared with the other containers using the same AttributeSet.
+		Ref<AttributeWorld> world;
+		/// @brief The container slot in the world.
+		uint32_t world_slot = 0;
+		/// @brief If the container holds a slot in the world.
+		bool world_bound = false;
+		/// @brief Recycled arguments of the `_compute_value` calls.
+		ObjectPool<AttributeComputationArgument> argument_pool;
+		/// @brief Recycled RuntimeBuff wrappers.
+		ObjectPool<RuntimeBuff> buff_pool;
+		/// @brief Scratch buffer of the runtime attributes affected by an overridden buff, reused between `apply_buff` calls.
+		LocalVector<Ref<RuntimeAttribute>> scratch_attributes;
+		/// @brief Scratch buffer of the static target handles of an overridden buff, reused between `apply_buff` calls.
+		LocalVector<int> scratch_handles;
+		/// @brief If an `apply_buff` call is using the scratch buffers. Nested calls, made by the listeners, use their own buffer.
+		bool scratch_in_use = false;
+
+		/// @brief An attribute value change collected while coalescing.
+		struct PendingChange
+		{
+			/// @brief The attribute handle.
+			int handle = -1;
+			/// @brief The value before the first change of the frame.
+			attribute_value_t previous_value = 0.0f;
+			/// @brief The value after the last change of the frame.
+			attribute_value_t value = 0.0f;
+		};
+
+		/// @brief The value changes collected since the last flush, one per attribute.
+		LocalVector<PendingChange> pending_changes;
+		/// @brief The index in `pending_changes` of each attribute handle, -1 if the attribute did not change.
+		LocalVector<int> pending_change_slots;
+		/// @brief The buffs whose time elapsed since the last flush, packed as handle and id.
+		LocalVector<uint64_t> pending_buffs;
+		/// @brief The keys of `pending_buffs`, to collect each buff once.
+		HashSet<uint64_t> pending_buff_keys;
+
+		/// @brief The default number of changes kept by the journal.
+		static constexpr int DEFAULT_JOURNAL_CAPACITY = 128;
+
+		/// @brief A journaled attribute change.
+		struct JournalEntry
+		{
+			/// @brief The container version after the change.
+			uint64_t version = 0;
+			/// @brief The attribute handle.
+			int handle = -1;
+		};
+
+		/// @brief Bumped each time an attribute value or buffs change, or when attributes are added or removed.
+		uint64_t version = 0;
+		/// @brief The last changes, a ring buffer of up to `journal_capacity` entries.
+		LocalVector<JournalEntry> journal;
+		/// @brief The index of the oldest journal entry.
+		uint32_t journal_head = 0;
+		/// @brief The changes up to this version are no longer journaled.
+		uint64_t journal_floor = 0;
+		/// @brief The maximum number of journal entries.
+		int journal_capacity = DEFAULT_JOURNAL_CAPACITY;
+		/// @brief The `get_changes_since` call that last listed each handle, to list each handle once.
+		mutable LocalVector<uint32_t> journal_marks;
+		/// @brief The number of `get_changes_since` calls, used as the mark of the current call.
+		mutable uint32_t journal_query = 0;
 
 		/// @brief Receives a notification.
 		/// @param p_what The notification.
 		// ReSharper disable once CppHidingFunction
 		void _notification(int p_what);
 
-		/// @brief Handles the attribute_changed signal.
+		/// @brief Called by a runtime attribute when its value changes.
 		/// @param p_attribute The attribute that changed.
 		/// @param p_previous_value The previous value of the attribute.
 		/// @param p_new_value The new value of the attribute.
-		void _on_attribute_changed(const Ref<RuntimeAttribute> &p_attribute, float p_previous_value, float p_new_value);
-
-		/// @brief Handles the buff_applied signal.
-		/// @param p_buff The buff that was applied.
-		void _on_buff_applied(RuntimeBuff *p_buff);
-
-		/// @brief Handles the buff_removed signal.
-		/// @param p_buff The buff that was removed.
-		void _on_buff_removed(const Ref<RuntimeBuff> &p_buff);
-
-		/// @brief Handles the buff_time_updated signal.
-		/// @param p_buff The buff that was updated.
-		void _on_buff_time_updated(const Ref<RuntimeBuff> &p_buff);
+		void _on_attribute_changed(RuntimeAttribute *p_attribute, attribute_value_t p_previous_value, attribute_value_t p_new_value);
+
+		/// @brief Called by a runtime attribute when a buff is stored.
+		/// @param p_attribute The runtime attribute.
+		/// @param p_id The buff record id.
+		void _on_buff_applied(RuntimeAttribute *p_attribute, uint32_t p_id);
+
+		/// @brief Called by a runtime attribute when a buff is removed.
+		/// @param p_attribute The runtime attribute.
+		/// @param p_buff The removed buff wrapper, null if nobody was listening.
+		void _on_buff_removed(RuntimeAttribute *p_attribute, const Ref<RuntimeBuff> &p_buff);
+
+		/// @brief Called by a runtime attribute when a buff time left is merged.
+		/// @param p_attribute The runtime attribute.
+		/// @param p_id The buff record id.
+		void _on_buff_time_updated(RuntimeAttribute *p_attribute, uint32_t p_id);
+
+		/// @brief Gets the default value of an attribute of the set, read in place of the attributes not materialized yet.
+		/// @param p_handle The attribute handle.
+		/// @return The default value, 0.0 if the handle is not valid.
+		[[nodiscard]] attribute_real_t get_default_value(int p_handle) const;
+
+		/// @brief Creates the runtime attribute of a sparse container attribute, if it does not exist yet.
+		/// @param p_handle The attribute handle.
+		/// @return The runtime attribute, nullptr if the handle is not valid.
+		RuntimeAttribute *materialize_attribute(int p_handle);
+		/// @brief Pushes a multi-attribute buff to one of its targets, notifying the enqueued buff.
+		/// @param p_attribute The target runtime attribute.
+		/// @param p_buff The buff.
+		/// @param p_operand The operation type computed for the target, see `OperationType`.
+		/// @param p_value The operation value computed for the target.
+		void push_operated_buff(RuntimeAttribute *p_attribute, const Ref<AttributeBuff> &p_buff, int p_operand, attribute_value_t p_value);
+		/// @brief Applies a buff overriding `_operate` or `_operate_packed` to the attributes it targets.
+		/// @param p_buff The buff.
+		/// @param r_handles The buffer collecting the static target handles, if the buff has static targets.
+		/// @param r_targets The buffer collecting the targets. The targets are held by reference, so listeners removing them do not free them.
+		void apply_operated_buff(const Ref<AttributeBuff> &p_buff, LocalVector<int> &r_handles, LocalVector<Ref<RuntimeAttribute>> &r_targets);
+
+		/// @brief Takes a slot in the world, if any.
+		void bind_world();
+
+		/// @brief Moves the attribute values back from the world and frees the container slot.
+		void unbind_world();
+
+		/// @brief Drops every runtime attribute, detaching them so the ones still referenced elsewhere stop calling the container.
+		void clear_attributes();
+
+		/// @brief Discards the changes collected since the last flush.
+		void clear_pending_changes();
+
+		/// @brief Bumps the version and journals an attribute change. Called by the runtime attributes.
+		/// @param p_attribute The changed runtime attribute.
+		void record_change(const RuntimeAttribute *p_attribute);
+
+		/// @brief Clears the journal, the changes up to the current version are no longer covered.
+		void reset_journal();
+
+		/// @brief Collects a buff time elapsed notification.
+		/// @param p_attribute The runtime attribute.
+		/// @param p_index The buff record index.
+		void queue_buff_change(const RuntimeAttribute *p_attribute, uint32_t p_index);
+
+		/// @brief Collects a value change notification.
+		/// @param p_attribute The runtime attribute.
+		/// @param p_previous_value The previous value.
+		/// @param p_new_value The new value.
+		void queue_change(const RuntimeAttribute *p_attribute, attribute_value_t p_previous_value, attribute_value_t p_new_value);
+
+		/// @brief Defers a `flush_changes` call to the end of the frame, once.
+		void schedule_flush();
+
+		/// @brief Reads a value of an attribute by handle, the default value if it is not materialized.
+		/// @param p_handle The attribute handle.
+		/// @param p_kind The value to read.
+		/// @return The value.
+		[[nodiscard]] attribute_real_t read_value(int p_handle, ValueKind p_kind) const;
+
+		/// @brief Reads a value of an attribute by name, the default value if it is not materialized.
+		/// @param p_name The attribute name.
+		/// @param p_kind The value to read.
+		/// @return The value.
+		[[nodiscard]] attribute_real_t read_value(const StringName &p_name, ValueKind p_kind) const;
+
+		/// @brief Writes the value of an attribute, materializing it in sparse mode.
+		/// @param p_attribute The runtime attribute, nullptr to skip.
+		/// @param p_value The value.
+		static void write_value(RuntimeAttribute *p_attribute, attribute_real_t p_value);
 
 		/// @brief Checks if the container has a specific attribute.
 		[[nodiscard]] bool has_attribute(const Ref<AttributeBase> &p_attribute) const;
@@ -155,4 +474,6 @@ namespace octod::gameplay::attributes
 	};
 } //namespace octod::gameplay::attributes
 
+VARIANT_ENUM_CAST(octod::gameplay::attributes::AttributeContainer::ValueKind);
+
 #endif
@@ -0,0 +1,128 @@
+/**************************************************************************/
+/*  attribute_native_api.cpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Read the license file in this repo.						              */
+/**************************************************************************/
+
+#include "attribute_native_api.hpp"
+
+#include "attribute.hpp"
+#include "attribute_container.hpp"
+
+#include <godot_cpp/core/object.hpp>
+
+using namespace octod::gameplay::attributes;
+
+namespace octod::gameplay::attributes
+{
+	/// @brief Implements the functions of the GameplayAttributesNativeApi table.
+	class AttributeNativeApi
+	{
+	public:
+		static GameplayAttributesContainer get_container(const uint64_t p_instance_id)
+		{
+			return Object::cast_to<AttributeContainer>(ObjectDB::get_instance(p_instance_id));
+		}
+
+		static int32_t resolve_handle(GameplayAttributesContainer p_container, const char *p_name)
+		{
+			ERR_FAIL_NULL_V_MSG(p_container, -1, "Container cannot be null.");
+			return as_container(p_container)->resolve_handle(StringName(String::utf8(p_name)));
+		}
+
+		static double get_value(GameplayAttributesContainer p_container, const int32_t p_handle, const GameplayAttributesValueKind p_kind)
+		{
+			ERR_FAIL_NULL_V_MSG(p_container, 0.0, "Container cannot be null.");
+			return as_container(p_container)->read_value(p_handle, static_cast<AttributeContainer::ValueKind>(p_kind));
+		}
+
+		static void get_values(GameplayAttributesContainer p_container, const int32_t *p_handles, double *r_values, const int64_t p_count, const GameplayAttributesValueKind p_kind)
+		{
+			ERR_FAIL_NULL_MSG(p_container, "Container cannot be null.");
+
+			const AttributeContainer *container = as_container(p_container);
+
+			for (int64_t i = 0; i < p_count; i++) {
+				r_values[i] = container->read_value(p_handles[i], static_cast<AttributeContainer::ValueKind>(p_kind));
+			}
+		}
+
+		static void set_value(GameplayAttributesContainer p_container, const int32_t p_handle, const double p_value)
+		{
+			ERR_FAIL_NULL_MSG(p_container, "Container cannot be null.");
+			AttributeContainer::write_value(as_container(p_container)->materialize_attribute(p_handle), static_cast<attribute_real_t>(p_value));
+		}
+
+		static void apply_buff(GameplayAttributesContainer p_container, const int32_t p_handle, const uint64_t p_buff_instance_id)
+		{
+			ERR_FAIL_NULL_MSG(p_container, "Container cannot be null.");
+
+			const Ref<AttributeBuff> buff = Object::cast_to<AttributeBuff>(ObjectDB::get_instance(p_buff_instance_id));
+
+			ERR_FAIL_COND_MSG(buff.is_null(), "The buff instance id is not an AttributeBuff.");
+
+			if (p_handle >= 0) {
+				as_container(p_container)->apply_buff_by_handle(p_handle, buff);
+			} else {
+				as_container(p_container)->apply_buff(buff);
+			}
+		}
+
+		static void remove_buff(GameplayAttributesContainer p_container, const uint64_t p_buff_instance_id)
+		{
+			ERR_FAIL_NULL_MSG(p_container, "Container cannot be null.");
+
+			const Ref<AttributeBuff> buff = Object::cast_to<AttributeBuff>(ObjectDB::get_instance(p_buff_instance_id));
+
+			ERR_FAIL_COND_MSG(buff.is_null(), "The buff instance id is not an AttributeBuff.");
+
+			as_container(p_container)->remove_buff(buff);
+		}
+
+		static void tick(GameplayAttributesContainer p_container, const float p_tick)
+		{
+			ERR_FAIL_NULL_MSG(p_container, "Container cannot be null.");
+			as_container(p_container)->subtract_attribute_buffs_ticks(p_tick);
+		}
+
+		static int64_t get_version(GameplayAttributesContainer p_container)
+		{
+			ERR_FAIL_NULL_V_MSG(p_container, 0, "Container cannot be null.");
+			return as_container(p_container)->get_version();
+		}
+
+		/// @brief The table handed out by `AttributeContainer::get_native_api`.
+		static const GameplayAttributesNativeApi table;
+
+	private:
+		static AttributeContainer *as_container(GameplayAttributesContainer p_container)
+		{
+			return static_cast<AttributeContainer *>(p_container);
+		}
+	};
+
+	const GameplayAttributesNativeApi AttributeNativeApi::table = {
+		GAMEPLAY_ATTRIBUTES_NATIVE_API_VERSION,
+		sizeof(GameplayAttributesNativeApi),
+		&AttributeNativeApi::get_container,
+		&AttributeNativeApi::resolve_handle,
+		&AttributeNativeApi::get_value,
+		&AttributeNativeApi::get_values,
+		&AttributeNativeApi::set_value,
+		&AttributeNativeApi::apply_buff,
+		&AttributeNativeApi::remove_buff,
+		&AttributeNativeApi::tick,
+		&AttributeNativeApi::get_version,
+	};
+} //namespace octod::gameplay::attributes
+
+int64_t AttributeContainer::get_native_api(const int p_version)
+{
+	/// the table only grows, so every version up to the current one is served by the same table.
+	ERR_FAIL_COND_V_MSG(p_version < 1 || p_version > GAMEPLAY_ATTRIBUTES_NATIVE_API_VERSION, 0, "Native API version " + String::num_int64(p_version) + " is not supported, the addon supports up to version " + String::num_int64(GAMEPLAY_ATTRIBUTES_NATIVE_API_VERSION) + ".");
+	return reinterpret_cast<int64_t>(&AttributeNativeApi::table);
+}
@@ -0,0 +1,102 @@
+/**************************************************************************/
+/*  attribute_native_api.hpp                                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Read the license file in this repo.						              */
+/**************************************************************************/
+
+#ifndef OCTOD_GAMEPLAY_ATTRIBUTES_ATTRIBUTE_NATIVE_API_H
+#define OCTOD_GAMEPLAY_ATTRIBUTES_ATTRIBUTE_NATIVE_API_H
+
+/// This header is the public native API of the addon, for other GDExtensions.
+/// It depends on the standard library only, copy it in your extension sources and do not include any other header of the addon.
+///
+/// Fetch the API once, when your extension initializes:
+///
+///     const int64_t address = ClassDBSingleton::get_singleton()->class_call_static("AttributeContainer", "get_native_api", GAMEPLAY_ATTRIBUTES_NATIVE_API_VERSION);
+///     const GameplayAttributesNativeApi *api = reinterpret_cast<const GameplayAttributesNativeApi *>(address);
+///
+/// The address is 0 if the loaded addon does not support the requested version.
+
+#include <cstdint>
+
+/// @brief The version of the API declared by this header. New versions only append functions to GameplayAttributesNativeApi.
+#define GAMEPLAY_ATTRIBUTES_NATIVE_API_VERSION 1
+
+/// @brief An AttributeContainer, as returned by `GameplayAttributesNativeApi::get_container`. Valid until the container is freed.
+typedef void *GameplayAttributesContainer;
+
+/// @brief The values read by `get_value` and `get_values`, same as `AttributeContainer.ValueKind`.
+enum GameplayAttributesValueKind : int32_t
+{
+	GAMEPLAY_ATTRIBUTES_VALUE_KIND_VALUE = 0,
+	GAMEPLAY_ATTRIBUTES_VALUE_KIND_BUFFED = 1,
+	GAMEPLAY_ATTRIBUTES_VALUE_KIND_PREVIOUS = 2,
+};
+
+/// @brief The native API, a table of plain functions. No Variant is built and no method is looked up by name.
+struct GameplayAttributesNativeApi
+{
+	/// @brief The version of the table, at least the requested one.
+	uint32_t version;
+	/// @brief The size of the table in bytes.
+	uint32_t size;
+
+	/// @brief Gets a container by instance id.
+	/// @param p_instance_id The container instance id, see `Object::get_instance_id`.
+	/// @return The container, nullptr if the object is not an AttributeContainer.
+	GameplayAttributesContainer (*get_container)(uint64_t p_instance_id);
+
+	/// @brief Resolves an attribute name into its handle.
+	/// @param p_container The container.
+	/// @param p_name The attribute name, UTF-8.
+	/// @return The attribute handle, -1 if the attribute is not in the container attribute set.
+	int32_t (*resolve_handle)(GameplayAttributesContainer p_container, const char *p_name);
+
+	/// @brief Gets a value of an attribute.
+	/// @param p_container The container.
+	/// @param p_handle The attribute handle.
+	/// @param p_kind The value to read.
+	/// @return The value.
+	double (*get_value)(GameplayAttributesContainer p_container, int32_t p_handle, GameplayAttributesValueKind p_kind);
+
+	/// @brief Gets a value of many attributes.
+	/// @param p_container The container.
+	/// @param p_handles The attribute handles.
+	/// @param r_values The values, as many as the handles.
+	/// @param p_count The number of handles.
+	/// @param p_kind The value to read.
+	void (*get_values)(GameplayAttributesContainer p_container, const int32_t *p_handles, double *r_values, int64_t p_count, GameplayAttributesValueKind p_kind);
+
+	/// @brief Sets the value of an attribute. The value is clamped and notified as any other change.
+	/// @param p_container The container.
+	/// @param p_handle The attribute handle.
+	/// @param p_value The value.
+	void (*set_value)(GameplayAttributesContainer p_container, int32_t p_handle, double p_value);
+
+	/// @brief Applies a buff.
+	/// @param p_container The container.
+	/// @param p_handle The handle of the buffed attribute, -1 to resolve the attributes as `AttributeContainer.apply_buff` does.
+	/// @param p_buff_instance_id The AttributeBuff instance id.
+	void (*apply_buff)(GameplayAttributesContainer p_container, int32_t p_handle, uint64_t p_buff_instance_id);
+
+	/// @brief Removes a buff.
+	/// @param p_container The container.
+	/// @param p_buff_instance_id The AttributeBuff instance id.
+	void (*remove_buff)(GameplayAttributesContainer p_container, uint64_t p_buff_instance_id);
+
+	/// @brief Subtracts a tick from the timed buffs, as `AttributeContainer.subtract_attribute_buffs_ticks` does.
+	/// @param p_container The container.
+	/// @param p_tick The elapsed time.
+	void (*tick)(GameplayAttributesContainer p_container, float p_tick);
+
+	/// @brief Gets the container version, see `AttributeContainer.get_version`.
+	/// @param p_container The container.
+	/// @return The version.
+	int64_t (*get_version)(GameplayAttributesContainer p_container);
+};
+
+#endif
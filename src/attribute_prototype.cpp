@@ -0,0 +1,44 @@
+/**************************************************************************/
+/*  attribute_prototype.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Read the license file in this repo.						              */
+/**************************************************************************/
+
+#include "attribute_prototype.hpp"
+
+using namespace octod::gameplay::attributes;
+
+void AttributePrototype::_bind_methods()
+{
+	/// binds methods to godot
+	ClassDB::bind_method(D_METHOD("get_attribute_count"), &AttributePrototype::get_attribute_count);
+	ClassDB::bind_method(D_METHOD("get_attribute_set"), &AttributePrototype::get_attribute_set);
+	ClassDB::bind_method(D_METHOD("has_buffs"), &AttributePrototype::has_buffs);
+}
+
+int AttributePrototype::get_attribute_count() const
+{
+	int count = 0;
+
+	for (const AttributeState &state : states) {
+		if (state.attribute.is_valid()) {
+			count++;
+		}
+	}
+
+	return count;
+}
+
+Ref<AttributeSet> AttributePrototype::get_attribute_set() const
+{
+	return attribute_set;
+}
+
+bool AttributePrototype::has_buffs() const
+{
+	return buffs_captured;
+}
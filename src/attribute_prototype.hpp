@@ -0,0 +1,86 @@
+/**************************************************************************/
+/*  attribute_prototype.hpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Read the license file in this repo.						              */
+/**************************************************************************/
+
+// ReSharper disable CppClassCanBeFinal
+#ifndef OCTOD_GAMEPLAY_ATTRIBUTES_ATTRIBUTE_PROTOTYPE_H
+#define OCTOD_GAMEPLAY_ATTRIBUTES_ATTRIBUTE_PROTOTYPE_H
+
+#include "attribute.hpp"
+
+#include <godot_cpp/templates/local_vector.hpp>
+
+using namespace godot;
+
+namespace octod::gameplay::attributes
+{
+	class AttributeContainer;
+
+	/// @brief A snapshot of the runtime state of a set up AttributeContainer, used to set up other containers with bulk copies instead of the full setup path.
+	class AttributePrototype : public RefCounted
+	{
+		GDCLASS(AttributePrototype, RefCounted);
+
+		friend class AttributeContainer;
+
+	public:
+		/// @brief Gets the number of attributes captured by the prototype.
+		/// @return The number of attributes.
+		[[nodiscard]] int get_attribute_count() const;
+		/// @brief Gets the attribute set of the captured container.
+		/// @return The attribute set.
+		[[nodiscard]] Ref<AttributeSet> get_attribute_set() const;
+		/// @brief Returns if the prototype captured the buffs applied to the container.
+		/// @return True if the buffs were captured, false otherwise.
+		[[nodiscard]] bool has_buffs() const;
+
+	protected:
+		/// @brief Bind methods to Godot.
+		static void _bind_methods();
+
+		/// @brief A captured buff.
+		struct BuffState
+		{
+			/// @brief The buff definition.
+			Ref<AttributeBuff> buff;
+			/// @brief The time left before the buff expires.
+			float time_left = 0.0f;
+			/// @brief If the buff uses `operation` instead of its own operation.
+			bool overridden = false;
+			/// @brief The operation of a multi-attribute buff for the captured attribute.
+			RuntimeAttribute::OperationOverride operation;
+		};
+
+		/// @brief A captured runtime attribute.
+		struct AttributeState
+		{
+			/// @brief The attribute definition.
+			Ref<AttributeBase> attribute;
+			/// @brief The attribute value.
+			attribute_value_t value = 0.0f;
+			/// @brief The attribute previous value.
+			attribute_value_t previous_value = 0.0f;
+			/// @brief The handles of the attributes deriving from this one.
+			LocalVector<int> derived;
+			/// @brief The captured buffs, empty if the buffs were not captured.
+			LocalVector<BuffState> buffs;
+		};
+
+		/// @brief The attribute set of the captured container.
+		Ref<AttributeSet> attribute_set;
+		/// @brief The attribute set revision at capture time. The handles are valid only while the set keeps it.
+		uint32_t attribute_set_revision = 0;
+		/// @brief The captured attributes, indexed by attribute handle. Missing attributes have a null definition.
+		LocalVector<AttributeState> states;
+		/// @brief If the buffs were captured.
+		bool buffs_captured = false;
+	};
+} //namespace octod::gameplay::attributes
+
+#endif
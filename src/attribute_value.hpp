@@ -0,0 +1,334 @@
+/**************************************************************************/
+/*  attribute_value.hpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Read the license file in this repo.						              */
+/**************************************************************************/
+
+#ifndef OCTOD_GAMEPLAY_ATTRIBUTES_ATTRIBUTE_VALUE_H
+#define OCTOD_GAMEPLAY_ATTRIBUTES_ATTRIBUTE_VALUE_H
+
+#include <godot_cpp/core/math.hpp>
+
+#include <cmath>
+#include <cstdint>
+
+#if defined(GAMEPLAY_ATTRIBUTES_VALUE_DOUBLE) && defined(GAMEPLAY_ATTRIBUTES_VALUE_FIXED)
+#error "Only one of GAMEPLAY_ATTRIBUTES_VALUE_DOUBLE and GAMEPLAY_ATTRIBUTES_VALUE_FIXED can be defined."
+#endif
+
+using namespace godot;
+
+namespace octod::gameplay::attributes
+{
+	/// @brief A deterministic signed fixed-point number, 48 integer bits and 16 fractional bits.
+	/// @details Every operation is integer arithmetic, so the results are bit-exact on every platform. Products and quotients are computed on unsigned magnitudes split in 32-bit limbs, so no intermediate overflows.
+	/// The range is about ±1.4e14 with a 1/65536 resolution. Results outside of it saturate to the closest limit, dividing by zero gives zero.
+	/// Products are rounded toward negative infinity, quotients toward zero.
+	class FixedValue
+	{
+	public:
+		/// @brief The number of fractional bits.
+		static constexpr int FRACTIONAL_BITS = 16;
+		/// @brief The raw value of one.
+		static constexpr int64_t ONE = int64_t(1) << FRACTIONAL_BITS;
+
+		constexpr FixedValue() = default;
+
+		/// @brief Converts a real number, rounding to the nearest representable value.
+		/// @param p_value The real number.
+		FixedValue(const double p_value) : // NOLINT(*-explicit-constructor)
+			raw(from_real(p_value))
+		{
+		}
+
+		/// @brief Converts an integer.
+		/// @param p_value The integer.
+		constexpr FixedValue(const int p_value) : // NOLINT(*-explicit-constructor)
+			raw(static_cast<int64_t>(p_value) * ONE)
+		{
+		}
+
+		/// @brief Creates a value from its raw representation.
+		/// @param p_raw The raw representation.
+		/// @return The value.
+		static constexpr FixedValue from_raw(const int64_t p_raw)
+		{
+			FixedValue value;
+			value.raw = p_raw;
+			return value;
+		}
+
+		/// @brief Gets the raw representation.
+		/// @return The raw representation.
+		[[nodiscard]] constexpr int64_t get_raw() const
+		{
+			return raw;
+		}
+
+		explicit operator double() const
+		{
+			return static_cast<double>(raw) / static_cast<double>(ONE);
+		}
+
+		explicit operator float() const
+		{
+			return static_cast<float>(static_cast<double>(*this));
+		}
+
+		constexpr FixedValue operator-() const
+		{
+			return from_raw(raw == INT64_MIN ? INT64_MAX : -raw);
+		}
+
+		friend constexpr FixedValue operator+(const FixedValue p_left, const FixedValue p_right)
+		{
+			if (p_right.raw > 0 && p_left.raw > INT64_MAX - p_right.raw) {
+				return from_raw(INT64_MAX);
+			}
+
+			if (p_right.raw < 0 && p_left.raw < INT64_MIN - p_right.raw) {
+				return from_raw(INT64_MIN);
+			}
+
+			return from_raw(p_left.raw + p_right.raw);
+		}
+
+		friend constexpr FixedValue operator-(const FixedValue p_left, const FixedValue p_right)
+		{
+			if (p_right.raw < 0 && p_left.raw > INT64_MAX + p_right.raw) {
+				return from_raw(INT64_MAX);
+			}
+
+			if (p_right.raw > 0 && p_left.raw < INT64_MIN + p_right.raw) {
+				return from_raw(INT64_MIN);
+			}
+
+			return from_raw(p_left.raw - p_right.raw);
+		}
+
+		friend constexpr FixedValue operator*(const FixedValue p_left, const FixedValue p_right)
+		{
+			const bool negative = (p_left.raw < 0) != (p_right.raw < 0);
+			const uint64_t left = magnitude(p_left.raw);
+			const uint64_t right = magnitude(p_right.raw);
+
+			/// the 128-bit product of the magnitudes, from four 32-bit partial products.
+			const uint64_t low_low = (left & 0xFFFFFFFFu) * (right & 0xFFFFFFFFu);
+			const uint64_t low_high = (left & 0xFFFFFFFFu) * (right >> 32);
+			const uint64_t high_low = (left >> 32) * (right & 0xFFFFFFFFu);
+			const uint64_t high_high = (left >> 32) * (right >> 32);
+			const uint64_t middle = (low_low >> 32) + (low_high & 0xFFFFFFFFu) + (high_low & 0xFFFFFFFFu);
+			const uint64_t low = (low_low & 0xFFFFFFFFu) | (middle << 32);
+			const uint64_t high = high_high + (low_high >> 32) + (high_low >> 32) + (middle >> 32);
+
+			/// the shifted product needs more than 63 bits.
+			if (high >> (FRACTIONAL_BITS - 1) != 0) {
+				return from_magnitude(negative, UINT64_MAX);
+			}
+
+			uint64_t result = (high << (64 - FRACTIONAL_BITS)) | (low >> FRACTIONAL_BITS);
+
+			/// rounds toward negative infinity, as an arithmetic shift of the signed product would.
+			if (negative && (low & (ONE - 1)) != 0) {
+				result++;
+			}
+
+			return from_magnitude(negative, result);
+		}
+
+		friend constexpr FixedValue operator/(const FixedValue p_left, const FixedValue p_right)
+		{
+			if (p_right.raw == 0) {
+				return {};
+			}
+
+			const bool negative = (p_left.raw < 0) != (p_right.raw < 0);
+			const uint64_t left = magnitude(p_left.raw);
+			const uint64_t right = magnitude(p_right.raw);
+			const uint64_t quotient = left / right;
+			uint64_t remainder = left % right;
+
+			if (quotient >> (63 - FRACTIONAL_BITS) != 0) {
+				return from_magnitude(negative, UINT64_MAX);
+			}
+
+			uint64_t fraction = 0;
+
+			if (right >> (64 - FRACTIONAL_BITS) == 0) {
+				/// the remainder is smaller than the divisor, so shifting it cannot overflow.
+				fraction = (remainder << FRACTIONAL_BITS) / right;
+			} else {
+				/// long division of the remainder, one fractional bit at a time. The carry keeps the bit shifted out of the remainder.
+				for (int i = 0; i < FRACTIONAL_BITS; i++) {
+					const bool carry = (remainder >> 63) != 0;
+
+					remainder <<= 1;
+					fraction <<= 1;
+
+					if (carry || remainder >= right) {
+						remainder -= right;
+						fraction |= 1;
+					}
+				}
+			}
+
+			return from_magnitude(negative, (quotient << FRACTIONAL_BITS) | fraction);
+		}
+
+		FixedValue &operator+=(const FixedValue p_value)
+		{
+			return *this = *this + p_value;
+		}
+
+		FixedValue &operator-=(const FixedValue p_value)
+		{
+			return *this = *this - p_value;
+		}
+
+		FixedValue &operator*=(const FixedValue p_value)
+		{
+			return *this = *this * p_value;
+		}
+
+		FixedValue &operator/=(const FixedValue p_value)
+		{
+			return *this = *this / p_value;
+		}
+
+		friend constexpr bool operator==(const FixedValue p_left, const FixedValue p_right)
+		{
+			return p_left.raw == p_right.raw;
+		}
+
+		friend constexpr bool operator!=(const FixedValue p_left, const FixedValue p_right)
+		{
+			return p_left.raw != p_right.raw;
+		}
+
+		friend constexpr bool operator<(const FixedValue p_left, const FixedValue p_right)
+		{
+			return p_left.raw < p_right.raw;
+		}
+
+		friend constexpr bool operator<=(const FixedValue p_left, const FixedValue p_right)
+		{
+			return p_left.raw <= p_right.raw;
+		}
+
+		friend constexpr bool operator>(const FixedValue p_left, const FixedValue p_right)
+		{
+			return p_left.raw > p_right.raw;
+		}
+
+		friend constexpr bool operator>=(const FixedValue p_left, const FixedValue p_right)
+		{
+			return p_left.raw >= p_right.raw;
+		}
+
+	private:
+		/// @brief The raw representation, the value multiplied by ONE.
+		int64_t raw = 0;
+
+		/// @brief Converts a real number to a raw representation, saturating out of range values. NaN converts to zero.
+		/// @param p_value The real number.
+		/// @return The raw representation.
+		static int64_t from_real(const double p_value)
+		{
+			const double scaled = std::round(p_value * static_cast<double>(ONE));
+
+			if (std::isnan(scaled)) {
+				return 0;
+			}
+
+			/// 2^63, the first double past the range.
+			if (scaled >= 9223372036854775808.0) {
+				return INT64_MAX;
+			}
+
+			if (scaled <= -9223372036854775808.0) {
+				return INT64_MIN;
+			}
+
+			return static_cast<int64_t>(scaled);
+		}
+
+		/// @brief Gets the magnitude of a raw representation, defined for INT64_MIN too.
+		/// @param p_raw The raw representation.
+		/// @return The magnitude.
+		static constexpr uint64_t magnitude(const int64_t p_raw)
+		{
+			return p_raw < 0 ? uint64_t(0) - static_cast<uint64_t>(p_raw) : static_cast<uint64_t>(p_raw);
+		}
+
+		/// @brief Creates a value from a sign and a magnitude, saturating magnitudes out of the range.
+		/// @param p_negative True if the value is negative.
+		/// @param p_magnitude The magnitude.
+		/// @return The value.
+		static constexpr FixedValue from_magnitude(const bool p_negative, const uint64_t p_magnitude)
+		{
+			if (p_magnitude > static_cast<uint64_t>(INT64_MAX)) {
+				return from_raw(p_negative ? INT64_MIN : INT64_MAX);
+			}
+
+			return from_raw(p_negative ? -static_cast<int64_t>(p_magnitude) : static_cast<int64_t>(p_magnitude));
+		}
+	};
+
+#if defined(GAMEPLAY_ATTRIBUTES_VALUE_DOUBLE)
+	/// @brief The type storing and operating the attribute values.
+	using attribute_value_t = double;
+	/// @brief The type exchanging the attribute values with Godot.
+	using attribute_real_t = double;
+#elif defined(GAMEPLAY_ATTRIBUTES_VALUE_FIXED)
+	/// @brief The type storing and operating the attribute values.
+	using attribute_value_t = FixedValue;
+	/// @brief The type exchanging the attribute values with Godot.
+	using attribute_real_t = double;
+#else
+	/// @brief The type storing and operating the attribute values.
+	using attribute_value_t = float;
+	/// @brief The type exchanging the attribute values with Godot.
+	using attribute_real_t = float;
+#endif
+
+	/// @brief Converts an attribute value to the type exchanged with Godot.
+	/// @param p_value The attribute value.
+	/// @return The real value.
+	_FORCE_INLINE_ attribute_real_t to_real(const attribute_value_t p_value)
+	{
+		return static_cast<attribute_real_t>(p_value);
+	}
+
+	/// @brief Checks if two attribute values are equal. Floating point values are compared approximately, fixed-point values exactly.
+	/// @param p_left The first value.
+	/// @param p_right The second value.
+	/// @return True if the values are equal, false otherwise.
+	_FORCE_INLINE_ bool is_equal_value(const float p_left, const float p_right)
+	{
+		return Math::is_equal_approx(p_left, p_right);
+	}
+
+	/// @brief Checks if two attribute values are equal. Floating point values are compared approximately, fixed-point values exactly.
+	/// @param p_left The first value.
+	/// @param p_right The second value.
+	/// @return True if the values are equal, false otherwise.
+	_FORCE_INLINE_ bool is_equal_value(const double p_left, const double p_right)
+	{
+		return Math::is_equal_approx(p_left, p_right);
+	}
+
+	/// @brief Checks if two attribute values are equal. Floating point values are compared approximately, fixed-point values exactly.
+	/// @param p_left The first value.
+	/// @param p_right The second value.
+	/// @return True if the values are equal, false otherwise.
+	_FORCE_INLINE_ bool is_equal_value(const FixedValue p_left, const FixedValue p_right)
+	{
+		return p_left == p_right;
+	}
+} //namespace octod::gameplay::attributes
+
+#endif
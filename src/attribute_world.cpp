@@ -0,0 +1,295 @@
+/**************************************************************************/
+/*  attribute_world.cpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Read the license file in this repo.						              */
+/**************************************************************************/
+
+#include "attribute_world.hpp"
+
+#include "attribute_container.hpp"
+#include "derived_attributes.hpp"
+
+using namespace octod::gameplay::attributes;
+
+void AttributeWorld::_bind_methods()
+{
+	/// binds methods to godot
+	ClassDB::bind_method(D_METHOD("add_value", "p_attribute_name", "p_amount"), &AttributeWorld::add_value);
+	ClassDB::bind_method(D_METHOD("get_attribute_set"), &AttributeWorld::get_attribute_set);
+	ClassDB::bind_method(D_METHOD("get_buffed_values", "p_attribute_name"), &AttributeWorld::get_buffed_values);
+	ClassDB::bind_method(D_METHOD("get_container_count"), &AttributeWorld::get_container_count);
+	ClassDB::bind_method(D_METHOD("get_containers"), &AttributeWorld::get_containers);
+	ClassDB::bind_method(D_METHOD("get_previous_values", "p_attribute_name"), &AttributeWorld::get_previous_values);
+	ClassDB::bind_method(D_METHOD("get_values", "p_attribute_name"), &AttributeWorld::get_values);
+	ClassDB::bind_method(D_METHOD("recompute_linear_attributes"), &AttributeWorld::recompute_linear_attributes);
+	ClassDB::bind_method(D_METHOD("set_attribute_set", "p_value"), &AttributeWorld::set_attribute_set);
+
+	/// binds properties to godot
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "attribute_set", PROPERTY_HINT_RESOURCE_TYPE, "AttributeSet"), "set_attribute_set", "get_attribute_set");
+}
+
+void AttributeWorld::add_value(const StringName &p_attribute_name, const attribute_real_t p_amount)
+{
+	ERR_FAIL_COND_MSG(attribute_set.is_null(), "AttributeWorld has no AttributeSet.");
+
+	const int handle = attribute_set->resolve_handle(p_attribute_name);
+
+	ERR_FAIL_COND_MSG(handle < 0 || static_cast<uint32_t>(handle) >= columns.size(), "Attribute '" + String(p_attribute_name) + "' not found in the world.");
+
+	if (p_amount == 0.0f) {
+		return;
+	}
+
+	const Lane &values = columns[handle].values;
+
+	for (uint32_t slot = 0; slot < containers.size(); slot++) {
+		const AttributeContainer *container = containers[slot];
+
+		if (container == nullptr || static_cast<uint32_t>(handle) >= container->handles.size()) {
+			continue;
+		}
+
+		/// the sweep reads the column, and goes through the view only to clamp and emit the change signals.
+		if (RuntimeAttribute *runtime_attribute = container->handles[handle]) {
+			runtime_attribute->commit_value(values.get(slot) + attribute_value_t(p_amount));
+		}
+	}
+}
+
+Ref<AttributeSet> AttributeWorld::get_attribute_set() const
+{
+	return attribute_set;
+}
+
+PackedFloat32Array AttributeWorld::get_buffed_values(const StringName &p_attribute_name) const
+{
+	PackedFloat32Array buffed_values;
+
+	if (const Column *column = get_column(p_attribute_name)) {
+		buffed_values.resize(column->values.size());
+
+		float *write = buffed_values.ptrw();
+
+		for (uint32_t slot = 0; slot < column->values.size(); slot++) {
+			write[slot] = static_cast<float>(column->get_buffed(slot));
+		}
+	}
+
+	return buffed_values;
+}
+
+int AttributeWorld::get_container_count() const
+{
+	return static_cast<int>(container_count);
+}
+
+TypedArray<AttributeContainer> AttributeWorld::get_containers() const
+{
+	TypedArray<AttributeContainer> result;
+
+	for (AttributeContainer *container : containers) {
+		if (container != nullptr) {
+			result.push_back(container);
+		}
+	}
+
+	return result;
+}
+
+PackedFloat32Array AttributeWorld::get_previous_values(const StringName &p_attribute_name) const
+{
+	PackedFloat32Array previous_values;
+
+	if (const Column *column = get_column(p_attribute_name)) {
+		previous_values.resize(column->previous_values.size());
+
+		float *write = previous_values.ptrw();
+
+		for (uint32_t slot = 0; slot < column->previous_values.size(); slot++) {
+			write[slot] = static_cast<float>(column->previous_values.get(slot));
+		}
+	}
+
+	return previous_values;
+}
+
+PackedFloat32Array AttributeWorld::get_values(const StringName &p_attribute_name) const
+{
+	PackedFloat32Array values;
+
+	if (const Column *column = get_column(p_attribute_name)) {
+		values.resize(column->values.size());
+
+		float *write = values.ptrw();
+
+		for (uint32_t slot = 0; slot < column->values.size(); slot++) {
+			write[slot] = static_cast<float>(column->values.get(slot));
+		}
+	}
+
+	return values;
+}
+
+void AttributeWorld::recompute_linear_attributes()
+{
+	ERR_FAIL_COND_MSG(attribute_set.is_null(), "AttributeWorld has no AttributeSet.");
+
+	LinearAttributeModel model;
+	model.build(attribute_set);
+
+	const uint32_t count = containers.size();
+
+	if (model.rows.is_empty() || count == 0) {
+		return;
+	}
+
+	LocalVector<attribute_real_t> inputs;
+	LocalVector<attribute_real_t> outputs;
+
+	inputs.resize(model.columns.size() * count);
+	outputs.resize(model.rows.size() * count);
+
+	for (uint32_t level = 0; level < model.get_level_count(); level++) {
+		/// the columns are already attribute-major, so gathering the buffed values is a linear sweep. Columns computed by the previous levels are gathered again, after their commit.
+		for (int64_t i = 0; i < model.columns.size(); i++) {
+			if (level > 0 && !model.is_column_stale(i, level)) {
+				continue;
+			}
+
+			attribute_real_t *input = inputs.ptr() + i * count;
+
+			if (const Column *column = get_column(model.columns[i])) {
+				for (uint32_t slot = 0; slot < count; slot++) {
+					input[slot] = to_real(column->get_buffed(slot));
+				}
+			} else {
+				for (uint32_t slot = 0; slot < count; slot++) {
+					input[slot] = 0.0f;
+				}
+			}
+		}
+
+		model.evaluate(inputs.ptr(), outputs.ptr(), count, level);
+
+		for (uint32_t i = model.level_offsets[level]; i < model.level_offsets[level + 1]; i++) {
+			const int handle = attribute_set->resolve_handle(model.rows[i]);
+
+			if (handle < 0) {
+				continue;
+			}
+
+			for (uint32_t slot = 0; slot < count; slot++) {
+				if (const AttributeContainer *container = containers[slot]; container != nullptr && static_cast<uint32_t>(handle) < container->handles.size()) {
+					if (RuntimeAttribute *runtime_attribute = container->handles[handle]) {
+						runtime_attribute->commit_value(outputs[i * count + slot]);
+					}
+				}
+			}
+		}
+	}
+}
+
+void AttributeWorld::set_attribute_set(const Ref<AttributeSet> &p_value)
+{
+	ERR_FAIL_COND_MSG(container_count > 0, "Cannot change the AttributeSet of a world with bound containers.");
+
+	attribute_set = p_value;
+	columns.clear();
+	emit_changed();
+}
+
+void AttributeWorld::ensure_column(const int p_handle)
+{
+	ERR_FAIL_COND_MSG(p_handle < 0, "Invalid attribute handle.");
+
+	if (static_cast<uint32_t>(p_handle) < columns.size()) {
+		return;
+	}
+
+	const uint32_t previous_size = columns.size();
+	const uint32_t slots = containers.size();
+
+	columns.resize(p_handle + 1);
+
+	for (uint32_t i = previous_size; i < columns.size(); i++) {
+		Column &column = columns[i];
+
+		column.values.half_precision = half_precision;
+		column.previous_values.half_precision = half_precision;
+		column.additives.half_precision = half_precision;
+		column.multipliers.half_precision = half_precision;
+		column.values.fill(slots, 0.0f);
+		column.previous_values.fill(slots, 0.0f);
+		column.additives.fill(slots, 0.0f);
+		column.multipliers.fill(slots, 1.0f);
+	}
+}
+
+uint32_t AttributeWorld::register_container(AttributeContainer *p_container)
+{
+	uint32_t slot;
+
+	/// the precision can only change while the world is empty, so the columns are dropped and rebuilt with the new storage.
+	if (container_count == 0 && attribute_set.is_valid()) {
+		if (const bool set_half_precision = attribute_set->get_storage_precision() == AttributeSet::STORAGE_PRECISION_HALF; set_half_precision != half_precision) {
+			half_precision = set_half_precision;
+			columns.clear();
+			containers.clear();
+			free_slots.clear();
+		}
+	}
+
+	if (!free_slots.is_empty()) {
+		slot = free_slots[free_slots.size() - 1];
+		free_slots.resize(free_slots.size() - 1);
+	} else {
+		slot = containers.size();
+		containers.push_back(nullptr);
+
+		for (Column &column : columns) {
+			column.values.push_back(0.0f);
+			column.previous_values.push_back(0.0f);
+			column.additives.push_back(0.0f);
+			column.multipliers.push_back(1.0f);
+		}
+	}
+
+	containers[slot] = p_container;
+	container_count++;
+
+	return slot;
+}
+
+void AttributeWorld::unregister_container(const uint32_t p_slot)
+{
+	ERR_FAIL_INDEX_MSG(p_slot, containers.size(), "Invalid container slot.");
+	ERR_FAIL_NULL_MSG(containers[p_slot], "Container slot is already free.");
+
+	for (Column &column : columns) {
+		column.values.set(p_slot, 0.0f);
+		column.previous_values.set(p_slot, 0.0f);
+		column.additives.set(p_slot, 0.0f);
+		column.multipliers.set(p_slot, 1.0f);
+	}
+
+	containers[p_slot] = nullptr;
+	free_slots.push_back(p_slot);
+	container_count--;
+}
+
+const AttributeWorld::Column *AttributeWorld::get_column(const StringName &p_attribute_name) const
+{
+	if (attribute_set.is_null()) {
+		return nullptr;
+	}
+
+	if (const int handle = attribute_set->resolve_handle(p_attribute_name); handle >= 0 && static_cast<uint32_t>(handle) < columns.size()) {
+		return &columns[handle];
+	}
+
+	return nullptr;
+}
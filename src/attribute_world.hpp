@@ -0,0 +1,192 @@
+/**************************************************************************/
+/*  attribute_world.hpp                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Read the license file in this repo.						              */
+/**************************************************************************/
+
+// ReSharper disable CppClassCanBeFinal
+#ifndef OCTOD_GAMEPLAY_ATTRIBUTES_ATTRIBUTE_WORLD_H
+#define OCTOD_GAMEPLAY_ATTRIBUTES_ATTRIBUTE_WORLD_H
+
+#include "attribute.hpp"
+
+#include <godot_cpp/templates/local_vector.hpp>
+
+using namespace godot;
+
+namespace octod::gameplay::attributes
+{
+	class AttributeContainer;
+
+	/// @brief Structure-of-arrays storage for the attribute values of all the containers sharing an AttributeSet.
+	/// @details Each attribute handle owns a set of contiguous float columns, indexed by container slot. Containers bound to a world store their values there, and their runtime attributes become views over those columns.
+	/// The columns store half floats when the AttributeSet storage precision is STORAGE_PRECISION_HALF, the values are converted back to floats when read.
+	class AttributeWorld : public Resource
+	{
+		GDCLASS(AttributeWorld, Resource);
+
+		friend class AttributeContainer;
+		friend class RuntimeAttribute;
+
+	public:
+		/// @brief Adds an amount to the value of an attribute on every container of the world, like a regeneration tick.
+		/// @param p_attribute_name The attribute name.
+		/// @param p_amount The amount to add.
+		void add_value(const StringName &p_attribute_name, attribute_real_t p_amount);
+		/// @brief Gets the attribute set shared by the containers of the world.
+		/// @return The attribute set.
+		[[nodiscard]] Ref<AttributeSet> get_attribute_set() const;
+		/// @brief Gets the buffed values of an attribute, one per container slot.
+		/// @param p_attribute_name The attribute name.
+		/// @return The buffed values.
+		[[nodiscard]] PackedFloat32Array get_buffed_values(const StringName &p_attribute_name) const;
+		/// @brief Gets the number of containers bound to the world.
+		/// @return The number of containers.
+		[[nodiscard]] int get_container_count() const;
+		/// @brief Gets the containers bound to the world, in slot order. Free slots are skipped.
+		/// @return The containers.
+		[[nodiscard]] TypedArray<AttributeContainer> get_containers() const;
+		/// @brief Gets the previous values of an attribute, one per container slot.
+		/// @param p_attribute_name The attribute name.
+		/// @return The previous values.
+		[[nodiscard]] PackedFloat32Array get_previous_values(const StringName &p_attribute_name) const;
+		/// @brief Gets the values of an attribute, one per container slot.
+		/// @param p_attribute_name The attribute name.
+		/// @return The values.
+		[[nodiscard]] PackedFloat32Array get_values(const StringName &p_attribute_name) const;
+		/// @brief Recomputes every LinearAttribute of every container of the world, reading the inputs straight from the columns.
+		void recompute_linear_attributes();
+		/// @brief Sets the attribute set shared by the containers of the world. It cannot change while containers are bound.
+		/// @param p_value The attribute set.
+		void set_attribute_set(const Ref<AttributeSet> &p_value);
+
+	protected:
+		/// @brief Bind methods to Godot.
+		static void _bind_methods();
+
+		/// @brief A single column, indexed by container slot. Only one of the two storages is used, depending on the precision.
+		struct Lane
+		{
+			/// @brief The full precision storage.
+			LocalVector<attribute_value_t> full;
+			/// @brief The half precision storage.
+			LocalVector<uint16_t> half;
+			/// @brief If the lane stores half floats.
+			bool half_precision = false;
+
+			/// @brief Gets the value of a slot.
+			/// @param p_slot The container slot.
+			/// @return The value.
+			[[nodiscard]] _FORCE_INLINE_ attribute_value_t get(const uint32_t p_slot) const
+			{
+				return half_precision ? attribute_value_t(Math::half_to_float(half[p_slot])) : full[p_slot];
+			}
+
+			/// @brief Sets the value of a slot.
+			/// @param p_slot The container slot.
+			/// @param p_value The value.
+			_FORCE_INLINE_ void set(const uint32_t p_slot, const attribute_value_t p_value)
+			{
+				if (half_precision) {
+					half[p_slot] = Math::make_half_float(static_cast<float>(p_value));
+				} else {
+					full[p_slot] = p_value;
+				}
+			}
+
+			/// @brief Appends a slot.
+			/// @param p_value The slot value.
+			void push_back(const attribute_value_t p_value)
+			{
+				if (half_precision) {
+					half.push_back(Math::make_half_float(static_cast<float>(p_value)));
+				} else {
+					full.push_back(p_value);
+				}
+			}
+
+			/// @brief Resizes the lane, filling every slot.
+			/// @param p_size The number of slots.
+			/// @param p_value The slot value.
+			void fill(const uint32_t p_size, const attribute_value_t p_value)
+			{
+				if (half_precision) {
+					const uint16_t half_value = Math::make_half_float(static_cast<float>(p_value));
+					half.resize(p_size);
+
+					for (uint32_t slot = 0; slot < p_size; slot++) {
+						half[slot] = half_value;
+					}
+				} else {
+					full.resize(p_size);
+
+					for (uint32_t slot = 0; slot < p_size; slot++) {
+						full[slot] = p_value;
+					}
+				}
+			}
+
+			/// @brief Gets the number of slots.
+			/// @return The number of slots.
+			[[nodiscard]] uint32_t size() const
+			{
+				return half_precision ? half.size() : full.size();
+			}
+		};
+
+		/// @brief The columns of a single attribute, indexed by container slot.
+		struct Column
+		{
+			/// @brief The base values.
+			Lane values;
+			/// @brief The previous values.
+			Lane previous_values;
+			/// @brief The sum of the add and subtract buffs.
+			Lane additives;
+			/// @brief The product of the multiply, divide and percentage buffs.
+			Lane multipliers;
+
+			/// @brief Gets the buffed value of a slot.
+			/// @param p_slot The container slot.
+			/// @return The buffed value.
+			[[nodiscard]] _FORCE_INLINE_ attribute_value_t get_buffed(const uint32_t p_slot) const
+			{
+				return (values.get(p_slot) + additives.get(p_slot)) * multipliers.get(p_slot);
+			}
+		};
+
+		/// @brief The attribute set shared by the containers.
+		Ref<AttributeSet> attribute_set;
+		/// @brief The columns, indexed by attribute handle.
+		LocalVector<Column> columns;
+		/// @brief The containers, indexed by slot. Free slots are stored as nullptr.
+		LocalVector<AttributeContainer *> containers;
+		/// @brief The free slots, reused before growing the columns.
+		LocalVector<uint32_t> free_slots;
+		/// @brief The number of bound containers.
+		uint32_t container_count = 0;
+		/// @brief If the columns store half floats, read from the AttributeSet when the first container binds.
+		bool half_precision = false;
+
+		/// @brief Makes sure there is a column for an attribute handle.
+		/// @param p_handle The attribute handle.
+		void ensure_column(int p_handle);
+		/// @brief Binds a container to the world.
+		/// @param p_container The container.
+		/// @return The container slot.
+		uint32_t register_container(AttributeContainer *p_container);
+		/// @brief Unbinds a container from the world, freeing its slot.
+		/// @param p_slot The container slot.
+		void unregister_container(uint32_t p_slot);
+		/// @brief Resolves an attribute name into its column.
+		/// @param p_attribute_name The attribute name.
+		/// @return The column, nullptr if the attribute is not in the set.
+		[[nodiscard]] const Column *get_column(const StringName &p_attribute_name) const;
+	};
+} //namespace octod::gameplay::attributes
+
+#endif
@@ -0,0 +1,843 @@
+/**************************************************************************/
+/*  derived_attributes.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Read the license file in this repo.						              */
+/**************************************************************************/
+
+#include "derived_attributes.hpp"
+
+using namespace octod::gameplay::attributes;
+
+namespace
+{
+	bool is_digit(const char32_t p_character)
+	{
+		return p_character >= '0' && p_character <= '9';
+	}
+
+	bool is_identifier_start(const char32_t p_character)
+	{
+		return (p_character >= 'a' && p_character <= 'z') || (p_character >= 'A' && p_character <= 'Z') || p_character == '_';
+	}
+
+	bool is_identifier_part(const char32_t p_character)
+	{
+		return is_identifier_start(p_character) || is_digit(p_character);
+	}
+} //namespace
+
+#pragma region ExpressionAttribute
+
+void ExpressionAttribute::_bind_methods()
+{
+	/// binds methods to godot
+	ClassDB::bind_method(D_METHOD("get_expression"), &ExpressionAttribute::get_expression);
+	ClassDB::bind_method(D_METHOD("get_variables"), &ExpressionAttribute::get_variables);
+	ClassDB::bind_method(D_METHOD("is_valid_expression"), &ExpressionAttribute::is_valid_expression);
+	ClassDB::bind_method(D_METHOD("set_expression", "p_value"), &ExpressionAttribute::set_expression);
+
+	/// binds properties to godot
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "expression", PROPERTY_HINT_EXPRESSION), "set_expression", "get_expression");
+}
+
+void ExpressionAttribute::Parser::emit(const Opcode p_opcode, const int p_stack_effect, const uint16_t p_index, const attribute_real_t p_constant)
+{
+	Instruction instruction;
+	instruction.opcode = p_opcode;
+	instruction.index = p_index;
+	instruction.constant = p_constant;
+
+	bytecode.push_back(instruction);
+	depth += p_stack_effect;
+	max_depth = MAX(max_depth, depth);
+}
+
+void ExpressionAttribute::Parser::fail(const String &p_error)
+{
+	if (error.is_empty()) {
+		error = p_error + " (at " + String::num_int64(position) + ")";
+	}
+}
+
+char32_t ExpressionAttribute::Parser::peek()
+{
+	while (position < source.length() && (source[position] == ' ' || source[position] == '\t' || source[position] == '\n' || source[position] == '\r')) {
+		position++;
+	}
+
+	return position < source.length() ? source[position] : 0;
+}
+
+bool ExpressionAttribute::Parser::match(const char32_t p_character)
+{
+	if (peek() == p_character) {
+		position++;
+		return true;
+	}
+
+	return false;
+}
+
+void ExpressionAttribute::Parser::parse_expression()
+{
+	parse_term();
+
+	while (error.is_empty()) {
+		if (match('+')) {
+			parse_term();
+			emit(OPCODE_ADD, -1);
+		} else if (match('-')) {
+			parse_term();
+			emit(OPCODE_SUBTRACT, -1);
+		} else {
+			break;
+		}
+	}
+}
+
+void ExpressionAttribute::Parser::parse_term()
+{
+	parse_unary();
+
+	while (error.is_empty()) {
+		if (match('*')) {
+			parse_unary();
+			emit(OPCODE_MULTIPLY, -1);
+		} else if (match('/')) {
+			parse_unary();
+			emit(OPCODE_DIVIDE, -1);
+		} else if (match('%')) {
+			parse_unary();
+			emit(OPCODE_MODULO, -1);
+		} else {
+			break;
+		}
+	}
+}
+
+void ExpressionAttribute::Parser::parse_unary()
+{
+	/// every recursion of the parser goes through here, so bounding it bounds the native stack too.
+	if (nesting >= MAX_NESTING) {
+		fail("The expression is too deeply nested");
+		return;
+	}
+
+	nesting++;
+
+	if (match('-')) {
+		parse_unary();
+		emit(OPCODE_NEGATE, 0);
+	} else if (match('+')) {
+		parse_unary();
+	} else {
+		parse_power();
+	}
+
+	nesting--;
+}
+
+void ExpressionAttribute::Parser::parse_power()
+{
+	parse_primary();
+
+	/// right associative, 2 ^ 3 ^ 2 is 2 ^ (3 ^ 2)
+	if (error.is_empty() && match('^')) {
+		parse_unary();
+		emit(OPCODE_POWER, -1);
+	}
+}
+
+void ExpressionAttribute::Parser::parse_primary()
+{
+	if (!error.is_empty()) {
+		return;
+	}
+
+	const char32_t character = peek();
+
+	if (is_digit(character) || character == '.') {
+		const int64_t start = position;
+
+		while (position < source.length() && (is_digit(source[position]) || source[position] == '.')) {
+			position++;
+		}
+
+		if (position < source.length() && (source[position] == 'e' || source[position] == 'E')) {
+			position++;
+
+			if (position < source.length() && (source[position] == '+' || source[position] == '-')) {
+				position++;
+			}
+
+			while (position < source.length() && is_digit(source[position])) {
+				position++;
+			}
+		}
+
+		emit(OPCODE_CONSTANT, 1, 0, static_cast<attribute_real_t>(source.substr(start, position - start).to_float()));
+	} else if (is_identifier_start(character)) {
+		const int64_t start = position;
+
+		while (position < source.length() && is_identifier_part(source[position])) {
+			position++;
+		}
+
+		const String name = source.substr(start, position - start);
+
+		if (match('(')) {
+			parse_call(name);
+		} else if (name == "value") {
+			emit(OPCODE_VALUE, 1);
+		} else {
+			int64_t index = variables.find(name);
+
+			if (index == -1) {
+				index = variables.size();
+				variables.push_back(name);
+			}
+
+			emit(OPCODE_VARIABLE, 1, static_cast<uint16_t>(index));
+		}
+	} else if (match('(')) {
+		parse_expression();
+
+		if (error.is_empty() && !match(')')) {
+			fail("Expected ')'");
+		}
+	} else if (character == 0) {
+		fail("Unexpected end of expression");
+	} else {
+		fail("Unexpected character '" + String::chr(character) + "'");
+	}
+}
+
+void ExpressionAttribute::Parser::parse_call(const String &p_name)
+{
+	int arguments = 0;
+
+	if (!match(')')) {
+		do {
+			parse_expression();
+			arguments++;
+		} while (error.is_empty() && match(','));
+
+		if (error.is_empty() && !match(')')) {
+			fail("Expected ')' after the arguments of '" + p_name + "'");
+			return;
+		}
+	}
+
+	if (!error.is_empty()) {
+		return;
+	}
+
+	Opcode opcode;
+	int arity;
+
+	if (p_name == "min") {
+		opcode = OPCODE_MIN;
+		arity = 2;
+	} else if (p_name == "max") {
+		opcode = OPCODE_MAX;
+		arity = 2;
+	} else if (p_name == "clamp") {
+		opcode = OPCODE_CLAMP;
+		arity = 3;
+	} else if (p_name == "pow") {
+		opcode = OPCODE_POWER;
+		arity = 2;
+	} else if (p_name == "abs") {
+		opcode = OPCODE_ABS;
+		arity = 1;
+	} else if (p_name == "floor") {
+		opcode = OPCODE_FLOOR;
+		arity = 1;
+	} else if (p_name == "ceil") {
+		opcode = OPCODE_CEIL;
+		arity = 1;
+	} else if (p_name == "round") {
+		opcode = OPCODE_ROUND;
+		arity = 1;
+	} else if (p_name == "sqrt") {
+		opcode = OPCODE_SQRT;
+		arity = 1;
+	} else {
+		fail("Unknown function '" + p_name + "'");
+		return;
+	}
+
+	if (arguments != arity) {
+		fail("Function '" + p_name + "' expects " + String::num_int64(arity) + " arguments, got " + String::num_int64(arguments));
+		return;
+	}
+
+	emit(opcode, 1 - arity);
+}
+
+String ExpressionAttribute::compile(const String &p_expression)
+{
+	bytecode.clear();
+	variables = PackedStringArray();
+	valid = false;
+
+	if (p_expression.strip_edges().is_empty()) {
+		return "The expression is empty.";
+	}
+
+	Parser parser;
+	parser.source = p_expression;
+	parser.parse_expression();
+
+	if (parser.error.is_empty() && parser.peek() != 0) {
+		parser.fail("Unexpected trailing characters");
+	}
+
+	if (parser.error.is_empty() && parser.max_depth > MAX_STACK_SIZE) {
+		parser.fail("The expression is too deeply nested");
+	}
+
+	if (!parser.error.is_empty()) {
+		return parser.error;
+	}
+
+	bytecode = parser.bytecode;
+	variables = parser.variables;
+	valid = true;
+
+	return {};
+}
+
+attribute_real_t ExpressionAttribute::evaluate(RuntimeAttribute *p_runtime_attribute, const attribute_real_t p_operated_value) const
+{
+	ERR_FAIL_COND_V_MSG(!valid, p_operated_value, "ExpressionAttribute '" + get_attribute_name() + "' has an invalid expression, cannot evaluate it.");
+
+	attribute_real_t stack[MAX_STACK_SIZE];
+	int top = -1;
+
+	for (uint32_t i = 0; i < bytecode.size(); i++) {
+		const Instruction &instruction = bytecode[i];
+
+		switch (instruction.opcode) {
+			case OPCODE_CONSTANT:
+				stack[++top] = instruction.constant;
+				break;
+			case OPCODE_VARIABLE: {
+				const RuntimeAttribute *parent = p_runtime_attribute->get_parent(instruction.index);
+				stack[++top] = parent ? parent->get_buffed_value() : 0.0f;
+			} break;
+			case OPCODE_VALUE:
+				stack[++top] = p_operated_value;
+				break;
+			case OPCODE_ADD:
+				top--;
+				stack[top] = stack[top] + stack[top + 1];
+				break;
+			case OPCODE_SUBTRACT:
+				top--;
+				stack[top] = stack[top] - stack[top + 1];
+				break;
+			case OPCODE_MULTIPLY:
+				top--;
+				stack[top] = stack[top] * stack[top + 1];
+				break;
+			case OPCODE_DIVIDE:
+				top--;
+				stack[top] = Math::abs(stack[top + 1]) < 0.0001f ? 0.0f : stack[top] / stack[top + 1];
+				break;
+			case OPCODE_MODULO:
+				top--;
+				stack[top] = Math::abs(stack[top + 1]) < 0.0001f ? 0.0f : Math::fmod(stack[top], stack[top + 1]);
+				break;
+			case OPCODE_POWER:
+				top--;
+				stack[top] = Math::pow(stack[top], stack[top + 1]);
+				break;
+			case OPCODE_NEGATE:
+				stack[top] = -stack[top];
+				break;
+			case OPCODE_MIN:
+				top--;
+				stack[top] = MIN(stack[top], stack[top + 1]);
+				break;
+			case OPCODE_MAX:
+				top--;
+				stack[top] = MAX(stack[top], stack[top + 1]);
+				break;
+			case OPCODE_CLAMP:
+				top -= 2;
+				stack[top] = CLAMP(stack[top], stack[top + 1], stack[top + 2]);
+				break;
+			case OPCODE_ABS:
+				stack[top] = Math::abs(stack[top]);
+				break;
+			case OPCODE_FLOOR:
+				stack[top] = Math::floor(stack[top]);
+				break;
+			case OPCODE_CEIL:
+				stack[top] = Math::ceil(stack[top]);
+				break;
+			case OPCODE_ROUND:
+				stack[top] = Math::round(stack[top]);
+				break;
+			case OPCODE_SQRT:
+				stack[top] = Math::sqrt(MAX(stack[top], attribute_real_t(0)));
+				break;
+		}
+	}
+
+	return top >= 0 ? stack[top] : p_operated_value;
+}
+
+String ExpressionAttribute::get_expression() const
+{
+	return expression;
+}
+
+PackedStringArray ExpressionAttribute::get_variables() const
+{
+	return variables;
+}
+
+bool ExpressionAttribute::is_valid_expression() const
+{
+	return valid;
+}
+
+void ExpressionAttribute::set_expression(const String &p_value)
+{
+	expression = p_value;
+
+	const String error = compile(p_value);
+
+	emit_changed();
+
+	ERR_FAIL_COND_MSG(!error.is_empty() && !p_value.is_empty(), "Invalid expression '" + p_value + "': " + error);
+}
+
+bool ExpressionAttribute::is_natively_computed() const
+{
+	return valid;
+}
+
+attribute_real_t ExpressionAttribute::compute_native_value(RuntimeAttribute *p_runtime_attribute, const attribute_real_t p_operated_value) const
+{
+	return evaluate(p_runtime_attribute, p_operated_value);
+}
+
+TypedArray<AttributeBase> ExpressionAttribute::get_native_derived_from(const Ref<AttributeSet> &p_attribute_set) const
+{
+	TypedArray<AttributeBase> derived;
+
+	ERR_FAIL_COND_V_MSG(p_attribute_set.is_null(), derived, "AttributeSet is null, cannot resolve the expression variables.");
+
+	for (int64_t i = 0; i < variables.size(); i++) {
+		derived.push_back(p_attribute_set->find_by_name(variables[i]));
+	}
+
+	return derived;
+}
+
+#pragma endregion
+
+#pragma region LinearAttribute
+
+void LinearAttribute::_bind_methods()
+{
+	/// binds methods to godot
+	ClassDB::bind_method(D_METHOD("get_bias"), &LinearAttribute::get_bias);
+	ClassDB::bind_method(D_METHOD("get_weights"), &LinearAttribute::get_weights);
+	ClassDB::bind_method(D_METHOD("set_bias", "p_value"), &LinearAttribute::set_bias);
+	ClassDB::bind_method(D_METHOD("set_weights", "p_value"), &LinearAttribute::set_weights);
+
+	/// binds properties to godot
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "bias"), "set_bias", "get_bias");
+	ADD_PROPERTY(PropertyInfo(Variant::DICTIONARY, "weights"), "set_weights", "get_weights");
+}
+
+attribute_real_t LinearAttribute::get_bias() const
+{
+	return bias;
+}
+
+Dictionary LinearAttribute::get_weights() const
+{
+	return weights;
+}
+
+void LinearAttribute::set_bias(const attribute_real_t p_value)
+{
+	bias = p_value;
+	emit_changed();
+}
+
+void LinearAttribute::set_weights(const Dictionary &p_value)
+{
+	weights = p_value;
+	names = PackedStringArray();
+	coefficients.clear();
+
+	const Array keys = p_value.keys();
+
+	for (int64_t i = 0; i < keys.size(); i++) {
+		const Variant weight = p_value[keys[i]];
+
+		ERR_CONTINUE_MSG(weight.get_type() != Variant::FLOAT && weight.get_type() != Variant::INT, "LinearAttribute weight for '" + String(keys[i]) + "' must be a number.");
+
+		names.push_back(keys[i]);
+		coefficients.push_back(weight);
+	}
+
+	emit_changed();
+}
+
+bool LinearAttribute::is_natively_computed() const
+{
+	return true;
+}
+
+attribute_real_t LinearAttribute::compute_native_value(RuntimeAttribute *p_runtime_attribute, [[maybe_unused]] attribute_real_t p_operated_value) const
+{
+	attribute_real_t total = bias;
+
+	for (uint32_t i = 0; i < coefficients.size(); i++) {
+		if (const RuntimeAttribute *parent = p_runtime_attribute->get_parent(static_cast<int>(i))) {
+			total += coefficients[i] * parent->get_buffed_value();
+		}
+	}
+
+	return total;
+}
+
+TypedArray<AttributeBase> LinearAttribute::get_native_derived_from(const Ref<AttributeSet> &p_attribute_set) const
+{
+	TypedArray<AttributeBase> derived;
+
+	ERR_FAIL_COND_V_MSG(p_attribute_set.is_null(), derived, "AttributeSet is null, cannot resolve the weighted attributes.");
+
+	for (int64_t i = 0; i < names.size(); i++) {
+		derived.push_back(p_attribute_set->find_by_name(names[i]));
+	}
+
+	return derived;
+}
+
+#pragma endregion
+
+#pragma region CurveAttribute
+
+void CurveAttribute::_bind_methods()
+{
+	/// binds methods to godot
+	ClassDB::bind_method(D_METHOD("bake"), &CurveAttribute::bake);
+	ClassDB::bind_method(D_METHOD("get_curve"), &CurveAttribute::get_curve);
+	ClassDB::bind_method(D_METHOD("get_input_attribute"), &CurveAttribute::get_input_attribute);
+	ClassDB::bind_method(D_METHOD("get_input_max"), &CurveAttribute::get_input_max);
+	ClassDB::bind_method(D_METHOD("get_input_min"), &CurveAttribute::get_input_min);
+	ClassDB::bind_method(D_METHOD("get_resolution"), &CurveAttribute::get_resolution);
+	ClassDB::bind_method(D_METHOD("get_samples"), &CurveAttribute::get_samples);
+	ClassDB::bind_method(D_METHOD("sample", "p_input"), &CurveAttribute::sample);
+	ClassDB::bind_method(D_METHOD("set_curve", "p_value"), &CurveAttribute::set_curve);
+	ClassDB::bind_method(D_METHOD("set_input_attribute", "p_value"), &CurveAttribute::set_input_attribute);
+	ClassDB::bind_method(D_METHOD("set_input_max", "p_value"), &CurveAttribute::set_input_max);
+	ClassDB::bind_method(D_METHOD("set_input_min", "p_value"), &CurveAttribute::set_input_min);
+	ClassDB::bind_method(D_METHOD("set_resolution", "p_value"), &CurveAttribute::set_resolution);
+	ClassDB::bind_method(D_METHOD("set_samples", "p_value"), &CurveAttribute::set_samples);
+
+	/// binds properties to godot
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "input_attribute"), "set_input_attribute", "get_input_attribute");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "input_min"), "set_input_min", "get_input_min");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "input_max"), "set_input_max", "get_input_max");
+	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "curve", PROPERTY_HINT_RESOURCE_TYPE, "Curve"), "set_curve", "get_curve");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "resolution", PROPERTY_HINT_RANGE, "2,4096,1"), "set_resolution", "get_resolution");
+	ADD_PROPERTY(PropertyInfo(Variant::PACKED_FLOAT32_ARRAY, "samples"), "set_samples", "get_samples");
+}
+
+void CurveAttribute::bake()
+{
+	lut.clear();
+	inverse_step = 0.0f;
+
+	const float range = input_max - input_min;
+
+	if (curve.is_valid()) {
+		lut.resize(resolution);
+
+		for (int i = 0; i < resolution; i++) {
+			lut[i] = curve->sample(input_min + range * static_cast<float>(i) / static_cast<float>(resolution - 1));
+		}
+	} else {
+		for (int64_t i = 0; i < samples.size(); i++) {
+			lut.push_back(samples[i]);
+		}
+	}
+
+	if (lut.size() >= 2 && !Math::is_zero_approx(range)) {
+		inverse_step = static_cast<float>(lut.size() - 1) / range;
+	}
+}
+
+float CurveAttribute::sample(const float p_input) const
+{
+	if (lut.size() < 2) {
+		return lut.is_empty() ? 0.0f : lut[0];
+	}
+
+	const uint32_t last = lut.size() - 1;
+	const float position = CLAMP((p_input - input_min) * inverse_step, 0.0f, static_cast<float>(last));
+	const uint32_t index = MIN(static_cast<uint32_t>(position), last - 1);
+
+	return Math::lerp(lut[index], lut[index + 1], position - static_cast<float>(index));
+}
+
+Ref<Curve> CurveAttribute::get_curve() const
+{
+	return curve;
+}
+
+String CurveAttribute::get_input_attribute() const
+{
+	return input_attribute;
+}
+
+float CurveAttribute::get_input_min() const
+{
+	return input_min;
+}
+
+float CurveAttribute::get_input_max() const
+{
+	return input_max;
+}
+
+int CurveAttribute::get_resolution() const
+{
+	return resolution;
+}
+
+PackedFloat32Array CurveAttribute::get_samples() const
+{
+	return samples;
+}
+
+void CurveAttribute::set_curve(const Ref<Curve> &p_value)
+{
+	const Callable bake_callable = Callable::create(this, "bake");
+
+	if (curve.is_valid() && curve->is_connected("changed", bake_callable)) {
+		curve->disconnect("changed", bake_callable);
+	}
+
+	curve = p_value;
+
+	if (curve.is_valid()) {
+		curve->connect("changed", bake_callable);
+	}
+
+	bake();
+	emit_changed();
+}
+
+void CurveAttribute::set_input_attribute(const String &p_value)
+{
+	input_attribute = p_value;
+	emit_changed();
+}
+
+void CurveAttribute::set_input_min(const float p_value)
+{
+	input_min = p_value;
+	bake();
+	emit_changed();
+}
+
+void CurveAttribute::set_input_max(const float p_value)
+{
+	input_max = p_value;
+	bake();
+	emit_changed();
+}
+
+void CurveAttribute::set_resolution(const int p_value)
+{
+	ERR_FAIL_COND_MSG(p_value < 2, "CurveAttribute resolution must be at least 2.");
+	resolution = p_value;
+	bake();
+	emit_changed();
+}
+
+void CurveAttribute::set_samples(const PackedFloat32Array &p_value)
+{
+	samples = p_value;
+	bake();
+	emit_changed();
+}
+
+bool CurveAttribute::is_natively_computed() const
+{
+	return !lut.is_empty() && !input_attribute.is_empty();
+}
+
+attribute_real_t CurveAttribute::compute_native_value(RuntimeAttribute *p_runtime_attribute, attribute_real_t p_operated_value) const
+{
+	const RuntimeAttribute *input = p_runtime_attribute->get_parent(0);
+	return input ? sample(static_cast<float>(input->get_buffed_value())) : p_operated_value;
+}
+
+TypedArray<AttributeBase> CurveAttribute::get_native_derived_from(const Ref<AttributeSet> &p_attribute_set) const
+{
+	TypedArray<AttributeBase> derived;
+
+	ERR_FAIL_COND_V_MSG(p_attribute_set.is_null(), derived, "AttributeSet is null, cannot resolve the input attribute.");
+
+	if (!input_attribute.is_empty()) {
+		derived.push_back(p_attribute_set->find_by_name(input_attribute));
+	}
+
+	return derived;
+}
+
+#pragma endregion
+
+#pragma region LinearAttributeModel
+
+void LinearAttributeModel::build(const Ref<AttributeSet> &p_attribute_set)
+{
+	rows = PackedStringArray();
+	columns = PackedStringArray();
+	row_offsets.clear();
+	column_indices.clear();
+	weights.clear();
+	biases.clear();
+	level_offsets.clear();
+	column_rows.clear();
+
+	ERR_FAIL_COND_MSG(p_attribute_set.is_null(), "AttributeSet is null, cannot build the linear model.");
+
+	LocalVector<LinearAttribute *> linear_attributes;
+	PackedStringArray linear_names;
+
+	for (int i = 0; i < p_attribute_set->count(); i++) {
+		const Ref<LinearAttribute> linear_attribute = p_attribute_set->get_at(i);
+
+		if (linear_attribute.is_valid()) {
+			linear_attributes.push_back(linear_attribute.ptr());
+			linear_names.push_back(linear_attribute->get_attribute_name());
+		}
+	}
+
+	/// a level is one more than the highest level of the weighted LinearAttribute instances, resolved in passes until nothing changes.
+	LocalVector<int> levels;
+	levels.resize(linear_attributes.size());
+
+	for (uint32_t i = 0; i < levels.size(); i++) {
+		levels[i] = -1;
+	}
+
+	int level_count = 0;
+
+	for (bool changed = true; changed;) {
+		changed = false;
+
+		for (uint32_t i = 0; i < linear_attributes.size(); i++) {
+			if (levels[i] >= 0) {
+				continue;
+			}
+
+			int level = 0;
+
+			for (int64_t j = 0; j < linear_attributes[i]->names.size() && level >= 0; j++) {
+				if (const int64_t input = linear_names.find(linear_attributes[i]->names[j]); input >= 0) {
+					level = levels[input] < 0 ? -1 : MAX(level, levels[input] + 1);
+				}
+			}
+
+			if (level >= 0) {
+				levels[i] = level;
+				level_count = MAX(level_count, level + 1);
+				changed = true;
+			}
+		}
+	}
+
+	row_offsets.push_back(0);
+
+	for (int level = 0; level < level_count; level++) {
+		level_offsets.push_back(rows.size());
+
+		for (uint32_t i = 0; i < linear_attributes.size(); i++) {
+			if (levels[i] != level) {
+				continue;
+			}
+
+			const LinearAttribute *linear_attribute = linear_attributes[i];
+
+			rows.push_back(linear_names[i]);
+			biases.push_back(linear_attribute->bias);
+
+			for (int64_t j = 0; j < linear_attribute->names.size(); j++) {
+				int64_t column = columns.find(linear_attribute->names[j]);
+
+				if (column == -1) {
+					column = columns.size();
+					columns.push_back(linear_attribute->names[j]);
+				}
+
+				column_indices.push_back(static_cast<uint32_t>(column));
+				weights.push_back(linear_attribute->coefficients[j]);
+			}
+
+			row_offsets.push_back(column_indices.size());
+		}
+	}
+
+	level_offsets.push_back(rows.size());
+
+	for (uint32_t i = 0; i < levels.size(); i++) {
+		ERR_CONTINUE_MSG(levels[i] < 0, "LinearAttribute '" + linear_names[i] + "' weights itself through other LinearAttribute instances, it is left out of the batched recompute.");
+	}
+
+	column_rows.resize(columns.size());
+
+	for (int64_t i = 0; i < columns.size(); i++) {
+		column_rows[i] = static_cast<int>(rows.find(columns[i]));
+	}
+}
+
+uint32_t LinearAttributeModel::get_level_count() const
+{
+	return level_offsets.is_empty() ? 0 : level_offsets.size() - 1;
+}
+
+bool LinearAttributeModel::is_column_stale(const uint32_t p_column, const uint32_t p_level) const
+{
+	return column_rows[p_column] >= 0 && static_cast<uint32_t>(column_rows[p_column]) < level_offsets[p_level];
+}
+
+void LinearAttributeModel::evaluate(const attribute_real_t *p_inputs, attribute_real_t *r_outputs, const uint32_t p_count, const uint32_t p_level) const
+{
+	for (uint32_t row = level_offsets[p_level]; row < level_offsets[p_level + 1]; row++) {
+		attribute_real_t *output = r_outputs + row * p_count;
+		const attribute_real_t bias = biases[row];
+
+		for (uint32_t c = 0; c < p_count; c++) {
+			output[c] = bias;
+		}
+
+		for (uint32_t k = row_offsets[row]; k < row_offsets[row + 1]; k++) {
+			const attribute_real_t weight = weights[k];
+			const attribute_real_t *input = p_inputs + column_indices[k] * p_count;
+
+			/// plain saxpy over contiguous memory, left to the compiler to vectorize.
+			for (uint32_t c = 0; c < p_count; c++) {
+				output[c] += weight * input[c];
+			}
+		}
+	}
+}
+
+#pragma endregion
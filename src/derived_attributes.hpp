@@ -0,0 +1,300 @@
+/**************************************************************************/
+/*  derived_attributes.hpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Read the license file in this repo.						              */
+/**************************************************************************/
+
+// ReSharper disable CppClassCanBeFinal
+#ifndef OCTOD_GAMEPLAY_ATTRIBUTES_DERIVED_ATTRIBUTES_H
+#define OCTOD_GAMEPLAY_ATTRIBUTES_DERIVED_ATTRIBUTES_H
+
+#include "attribute.hpp"
+
+#include <godot_cpp/classes/curve.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+using namespace godot;
+
+namespace octod::gameplay::attributes
+{
+	/// @brief Attribute whose value is computed natively from an expression over other attributes.
+	class ExpressionAttribute : public Attribute
+	{
+		GDCLASS(ExpressionAttribute, Attribute);
+
+	public:
+		/// @brief The maximum stack depth an expression can reach while evaluating.
+		static constexpr int MAX_STACK_SIZE = 32;
+		/// @brief The maximum nesting of parentheses, unary operators, powers and calls an expression can have while parsing.
+		static constexpr int MAX_NESTING = 64;
+
+		/// @brief Compiles an expression into bytecode.
+		/// @param p_expression The expression to compile.
+		/// @return An empty string if the expression compiled, the error message otherwise.
+		String compile(const String &p_expression);
+		/// @brief Evaluates the compiled expression.
+		/// @param p_runtime_attribute The runtime attribute the expression is evaluated for.
+		/// @param p_operated_value The value bound to the `value` keyword.
+		/// @return The expression result.
+		[[nodiscard]] attribute_real_t evaluate(RuntimeAttribute *p_runtime_attribute, attribute_real_t p_operated_value) const;
+		/// @brief Gets the expression.
+		/// @return The expression.
+		[[nodiscard]] String get_expression() const;
+		/// @brief Gets the attribute names referenced by the expression, in order of first appearance.
+		/// @return The attribute names.
+		[[nodiscard]] PackedStringArray get_variables() const;
+		/// @brief Returns if the expression compiled successfully.
+		/// @return True if the expression is valid, false otherwise.
+		[[nodiscard]] bool is_valid_expression() const;
+		/// @brief Sets the expression, compiling it.
+		/// @param p_value The expression.
+		void set_expression(const String &p_value);
+
+		[[nodiscard]] bool is_natively_computed() const override;
+		[[nodiscard]] attribute_real_t compute_native_value(RuntimeAttribute *p_runtime_attribute, attribute_real_t p_operated_value) const override;
+		[[nodiscard]] TypedArray<AttributeBase> get_native_derived_from(const Ref<AttributeSet> &p_attribute_set) const override;
+
+	protected:
+		/// @brief Bind methods to Godot.
+		static void _bind_methods();
+
+		/// @brief Bytecode opcodes.
+		enum Opcode : uint8_t
+		{
+			OPCODE_CONSTANT,
+			OPCODE_VARIABLE,
+			OPCODE_VALUE,
+			OPCODE_ADD,
+			OPCODE_SUBTRACT,
+			OPCODE_MULTIPLY,
+			OPCODE_DIVIDE,
+			OPCODE_MODULO,
+			OPCODE_POWER,
+			OPCODE_NEGATE,
+			OPCODE_MIN,
+			OPCODE_MAX,
+			OPCODE_CLAMP,
+			OPCODE_ABS,
+			OPCODE_FLOOR,
+			OPCODE_CEIL,
+			OPCODE_ROUND,
+			OPCODE_SQRT,
+		};
+
+		/// @brief A single bytecode instruction.
+		struct Instruction
+		{
+			/// @brief The opcode.
+			Opcode opcode = OPCODE_CONSTANT;
+			/// @brief The variable index, used by OPCODE_VARIABLE.
+			uint16_t index = 0;
+			/// @brief The constant value, used by OPCODE_CONSTANT. Stored as `attribute_real_t`, so double and fixed builds keep constants like 0.1 as written.
+			attribute_real_t constant = 0.0f;
+		};
+
+		/// @brief Recursive descent parser, emitting bytecode in reverse polish notation.
+		struct Parser
+		{
+			/// @brief The expression being parsed.
+			String source;
+			/// @brief The current position in the source.
+			int64_t position = 0;
+			/// @brief The first error found, if any.
+			String error;
+			/// @brief The emitted bytecode.
+			LocalVector<Instruction> bytecode;
+			/// @brief The referenced attribute names.
+			PackedStringArray variables;
+			/// @brief The current stack depth.
+			int depth = 0;
+			/// @brief The maximum stack depth reached.
+			int max_depth = 0;
+			/// @brief The current recursion depth, bounded by MAX_NESTING.
+			int nesting = 0;
+
+			void emit(Opcode p_opcode, int p_stack_effect, uint16_t p_index = 0, attribute_real_t p_constant = 0.0f);
+			void fail(const String &p_error);
+			char32_t peek();
+			bool match(char32_t p_character);
+			void parse_expression();
+			void parse_term();
+			void parse_unary();
+			void parse_power();
+			void parse_primary();
+			void parse_call(const String &p_name);
+		};
+
+		/// @brief The expression source.
+		String expression;
+		/// @brief The compiled bytecode.
+		LocalVector<Instruction> bytecode;
+		/// @brief The attribute names referenced by the expression.
+		PackedStringArray variables;
+		/// @brief If the expression compiled successfully.
+		bool valid = false;
+	};
+
+	/// @brief Attribute whose value is a weighted sum of other attributes plus a bias, computed natively.
+	class LinearAttribute : public Attribute
+	{
+		GDCLASS(LinearAttribute, Attribute);
+
+		friend struct LinearAttributeModel;
+
+	public:
+		/// @brief Gets the bias.
+		/// @return The bias.
+		[[nodiscard]] attribute_real_t get_bias() const;
+		/// @brief Gets the weights, keyed by attribute name.
+		/// @return The weights.
+		[[nodiscard]] Dictionary get_weights() const;
+		/// @brief Sets the bias.
+		/// @param p_value The bias.
+		void set_bias(attribute_real_t p_value);
+		/// @brief Sets the weights, keyed by attribute name.
+		/// @param p_value The weights.
+		void set_weights(const Dictionary &p_value);
+
+		[[nodiscard]] bool is_natively_computed() const override;
+		[[nodiscard]] attribute_real_t compute_native_value(RuntimeAttribute *p_runtime_attribute, attribute_real_t p_operated_value) const override;
+		[[nodiscard]] TypedArray<AttributeBase> get_native_derived_from(const Ref<AttributeSet> &p_attribute_set) const override;
+
+	protected:
+		/// @brief Bind methods to Godot.
+		static void _bind_methods();
+
+		/// @brief The bias added to the weighted sum.
+		attribute_real_t bias = 0.0f;
+		/// @brief The weights, keyed by attribute name, as set by the user.
+		Dictionary weights;
+		/// @brief The weighted attribute names, in `get_derived_from` order.
+		PackedStringArray names;
+		/// @brief The weights, in `names` order.
+		LocalVector<attribute_real_t> coefficients;
+	};
+
+	/// @brief Attribute whose value is a curve of another attribute, baked into a lookup table and computed natively.
+	class CurveAttribute : public Attribute
+	{
+		GDCLASS(CurveAttribute, Attribute);
+
+	public:
+		/// @brief The default number of lookup table entries.
+		static constexpr int DEFAULT_RESOLUTION = 256;
+
+		/// @brief Bakes the curve or the samples into the lookup table.
+		void bake();
+		/// @brief Samples the lookup table.
+		/// @param p_input The input value.
+		/// @return The linearly interpolated output value.
+		[[nodiscard]] float sample(float p_input) const;
+		/// @brief Gets the curve.
+		/// @return The curve.
+		[[nodiscard]] Ref<Curve> get_curve() const;
+		/// @brief Gets the input attribute name.
+		/// @return The input attribute name.
+		[[nodiscard]] String get_input_attribute() const;
+		/// @brief Gets the input value mapped to the first lookup table entry.
+		/// @return The minimum input value.
+		[[nodiscard]] float get_input_min() const;
+		/// @brief Gets the input value mapped to the last lookup table entry.
+		/// @return The maximum input value.
+		[[nodiscard]] float get_input_max() const;
+		/// @brief Gets the number of lookup table entries baked from the curve.
+		/// @return The resolution.
+		[[nodiscard]] int get_resolution() const;
+		/// @brief Gets the sample table.
+		/// @return The samples.
+		[[nodiscard]] PackedFloat32Array get_samples() const;
+		/// @brief Sets the curve.
+		/// @param p_value The curve.
+		void set_curve(const Ref<Curve> &p_value);
+		/// @brief Sets the input attribute name.
+		/// @param p_value The input attribute name.
+		void set_input_attribute(const String &p_value);
+		/// @brief Sets the input value mapped to the first lookup table entry.
+		/// @param p_value The minimum input value.
+		void set_input_min(float p_value);
+		/// @brief Sets the input value mapped to the last lookup table entry.
+		/// @param p_value The maximum input value.
+		void set_input_max(float p_value);
+		/// @brief Sets the number of lookup table entries baked from the curve.
+		/// @param p_value The resolution.
+		void set_resolution(int p_value);
+		/// @brief Sets the sample table, used when no curve is set.
+		/// @param p_value The samples.
+		void set_samples(const PackedFloat32Array &p_value);
+
+		[[nodiscard]] bool is_natively_computed() const override;
+		[[nodiscard]] attribute_real_t compute_native_value(RuntimeAttribute *p_runtime_attribute, attribute_real_t p_operated_value) const override;
+		[[nodiscard]] TypedArray<AttributeBase> get_native_derived_from(const Ref<AttributeSet> &p_attribute_set) const override;
+
+	protected:
+		/// @brief Bind methods to Godot.
+		static void _bind_methods();
+
+		/// @brief The curve, sampled at input values.
+		Ref<Curve> curve;
+		/// @brief The input attribute name.
+		String input_attribute;
+		/// @brief The input value mapped to the first lookup table entry.
+		float input_min = 0.0f;
+		/// @brief The input value mapped to the last lookup table entry.
+		float input_max = 1.0f;
+		/// @brief The number of lookup table entries baked from the curve.
+		int resolution = DEFAULT_RESOLUTION;
+		/// @brief Uniformly spaced samples between input_min and input_max, used when no curve is set.
+		PackedFloat32Array samples;
+		/// @brief The baked lookup table.
+		LocalVector<float> lut;
+		/// @brief The inverse of the input step between two lookup table entries.
+		float inverse_step = 0.0f;
+	};
+
+	/// @brief All the LinearAttribute instances of an AttributeSet, stored as one sparse matrix (CSR).
+	/// @details Inputs and outputs are laid out attribute-major: the values of one attribute for all the evaluated containers are contiguous, so each non-zero weight is a single vectorizable multiply-add sweep.
+	/// Rows are grouped in dependency levels: a LinearAttribute weighting another one is in a later level, so its input column must be gathered again once the previous levels are committed.
+	struct LinearAttributeModel
+	{
+		/// @brief The LinearAttribute names, one per row, sorted by level.
+		PackedStringArray rows;
+		/// @brief The weighted attribute names, one per column.
+		PackedStringArray columns;
+		/// @brief Row start offsets into `column_indices` and `weights`. Has `rows.size() + 1` entries.
+		LocalVector<uint32_t> row_offsets;
+		/// @brief Column index of each non-zero weight.
+		LocalVector<uint32_t> column_indices;
+		/// @brief Non-zero weights.
+		LocalVector<attribute_real_t> weights;
+		/// @brief Bias of each row.
+		LocalVector<attribute_real_t> biases;
+		/// @brief First row of each level, followed by `rows.size()`.
+		LocalVector<uint32_t> level_offsets;
+		/// @brief The row computing each column, -1 if the column is not a LinearAttribute.
+		LocalVector<int> column_rows;
+
+		/// @brief Builds the model from the LinearAttribute instances of an attribute set. LinearAttribute instances weighting each other in a cycle are left out.
+		/// @param p_attribute_set The attribute set.
+		void build(const Ref<AttributeSet> &p_attribute_set);
+		/// @brief Gets the number of dependency levels.
+		/// @return The number of levels.
+		[[nodiscard]] uint32_t get_level_count() const;
+		/// @brief Checks if a column must be gathered again before evaluating a level, because a previous level computes it.
+		/// @param p_column The column index.
+		/// @param p_level The level.
+		/// @return True if the column is computed by a previous level, false otherwise.
+		[[nodiscard]] bool is_column_stale(uint32_t p_column, uint32_t p_level) const;
+		/// @brief Evaluates the rows of a level for many containers at once.
+		/// @param p_inputs The column values, `columns.size() * p_count` values, attribute-major.
+		/// @param r_outputs The row values, `rows.size() * p_count` values, attribute-major. Only the rows of the level are written.
+		/// @param p_count The number of evaluated containers.
+		/// @param p_level The level.
+		void evaluate(const attribute_real_t *p_inputs, attribute_real_t *r_outputs, uint32_t p_count, uint32_t p_level) const;
+	};
+} //namespace octod::gameplay::attributes
+
+#endif
@@ -0,0 +1,137 @@
+/**************************************************************************/
+/*  object_pool.hpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                        Godot Gameplay Systems                          */
+/*              https://github.com/OctoD/godot-gameplay-systems           */
+/**************************************************************************/
+/* Read the license file in this repo.						              */
+/**************************************************************************/
+
+#ifndef OCTOD_GAMEPLAY_ATTRIBUTES_OBJECT_POOL_H
+#define OCTOD_GAMEPLAY_ATTRIBUTES_OBJECT_POOL_H
+
+#include <godot_cpp/classes/ref.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+
+using namespace godot;
+
+namespace octod::gameplay::attributes
+{
+	/// @brief A bounded pool of RefCounted objects, recycled once nobody but the pool references them.
+	/// @details Pooled objects are never returned explicitly: an object is free again as soon as its reference count drops back to one.
+	/// @tparam T The RefCounted class to pool.
+	template <typename T>
+	class ObjectPool
+	{
+	public:
+		/// @brief The default number of pooled objects.
+		static constexpr uint32_t DEFAULT_CAPACITY = 32;
+
+		/// @brief Gets a free object, instantiating a new one on a miss. The caller is responsible for resetting its state.
+		/// @return The object.
+		Ref<T> acquire()
+		{
+			const uint32_t size = objects.size();
+
+			/// scan from the last acquired object, recently released objects are likely close to it.
+			for (uint32_t i = 0; i < size; i++) {
+				const uint32_t index = (cursor + i) % size;
+
+				if (objects[index]->get_reference_count() == 1) {
+					cursor = (index + 1) % size;
+					hits++;
+					return objects[index];
+				}
+			}
+
+			Ref<T> object;
+			object.instantiate();
+			misses++;
+
+			if (size < capacity) {
+				objects.push_back(object);
+			}
+
+			return object;
+		}
+
+		/// @brief Releases every pooled object and resets the counters.
+		void clear()
+		{
+			objects.clear();
+			cursor = 0;
+			hits = 0;
+			misses = 0;
+		}
+
+		/// @brief Gets the maximum number of pooled objects.
+		/// @return The capacity.
+		[[nodiscard]] uint32_t get_capacity() const
+		{
+			return capacity;
+		}
+
+		/// @brief Gets the number of acquisitions served by a pooled object.
+		/// @return The hits.
+		[[nodiscard]] uint32_t get_hits() const
+		{
+			return hits;
+		}
+
+		/// @brief Gets the number of acquisitions that instantiated a new object.
+		/// @return The misses.
+		[[nodiscard]] uint32_t get_misses() const
+		{
+			return misses;
+		}
+
+		/// @brief Gets the number of pooled objects currently referenced outside of the pool.
+		/// @return The occupancy.
+		[[nodiscard]] uint32_t get_occupancy() const
+		{
+			uint32_t occupancy = 0;
+
+			for (const Ref<T> &object : objects) {
+				if (object->get_reference_count() > 1) {
+					occupancy++;
+				}
+			}
+
+			return occupancy;
+		}
+
+		/// @brief Gets the number of pooled objects.
+		/// @return The size.
+		[[nodiscard]] uint32_t get_size() const
+		{
+			return objects.size();
+		}
+
+		/// @brief Sets the maximum number of pooled objects, dropping the exceeding ones.
+		/// @param p_capacity The capacity.
+		void set_capacity(const uint32_t p_capacity)
+		{
+			capacity = p_capacity;
+
+			if (objects.size() > capacity) {
+				objects.resize(capacity);
+				cursor = 0;
+			}
+		}
+
+	private:
+		/// @brief The pooled objects.
+		LocalVector<Ref<T>> objects;
+		/// @brief The maximum number of pooled objects.
+		uint32_t capacity = DEFAULT_CAPACITY;
+		/// @brief Where the next scan starts.
+		uint32_t cursor = 0;
+		/// @brief The acquisitions served by a pooled object.
+		uint32_t hits = 0;
+		/// @brief The acquisitions that instantiated a new object.
+		uint32_t misses = 0;
+	};
+} //namespace octod::gameplay::attributes
+
+#endif
@@ -29,6 +29,9 @@
 
 #include "attribute.hpp"
 #include "attribute_container.hpp"
+#include "attribute_prototype.hpp"
+#include "attribute_world.hpp"
+#include "derived_attributes.hpp"
 #include <godot_cpp/core/class_db.hpp>
 
 using namespace godot;
@@ -43,10 +46,15 @@ void gdextension_initialize(ModuleInitializationLevel p_level)
 		ClassDB::register_class<AttributeBuff>();
 		ClassDB::register_abstract_class<AttributeBase>();
 		ClassDB::register_class<Attribute>();
+		ClassDB::register_class<ExpressionAttribute>();
+		ClassDB::register_class<LinearAttribute>();
+		ClassDB::register_class<CurveAttribute>();
 		ClassDB::register_class<AttributeSet>();
+		ClassDB::register_class<AttributeWorld>();
 		/// nodes
 		ClassDB::register_runtime_class<AttributeContainer>();
 		ClassDB::register_runtime_class<AttributeComputationArgument>();
+		ClassDB::register_class<AttributePrototype>();
 		/// runtime classes
 		ClassDB::register_runtime_class<RuntimeBuff>();
 		ClassDB::register_runtime_class<RuntimeAttribute>();